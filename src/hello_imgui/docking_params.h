@@ -280,7 +280,8 @@ struct DockingParams
     // --------------- Helper Methods -----------------------------
 
     // `DockableWindow * dockableWindowOfName(const std::string & name)`:
-    // returns a pointer to a dockable window
+    // returns a pointer to a dockable window, searched by label, or else by ImGui id
+    // (the part of the label starting at "###", e.g. "Renamed###inspector" finds "Inspector###inspector").
     std::shared_ptr<DockableWindow> dockableWindowOfName(const std::string& name);
 
     // `bool focusDockableWindow(const std::string& name)`:
@@ -327,6 +328,21 @@ struct DockableWindow
     bool justAdded = true;
     bool wantsAutoDock = true;
     DockableWindowAdditionState state = DockableWindowAdditionState::Waiting;
+
+    // --------------- Render throttling (for heavy windows, e.g. plots) ---------------
+
+    // `maxRefreshRate`: _float, default=0 (i.e. refresh at every frame)_.
+    //  If > 0, GuiFunction is called at most maxRefreshRate times per second: on the other frames,
+    //  the draw commands of its last call are replayed. The window is refreshed at every frame
+    //  while it is hovered, focused or active, and as soon as it is moved, resized or scrolled.
+    //  Note: a GuiFunction which creates child windows (BeginChild, tables with ScrollX/ScrollY, ...)
+    //  is called at every frame, since the child windows cannot be replayed.
+    float maxRefreshRate = 0.f;
+    // `skipGuiWhenHidden`: _bool, default=false_.
+    //  If true, GuiFunction is not called while the window is hidden: entirely clipped,
+    //  or outside its viewport.
+    //  (GuiFunction is never called for a tab which is not selected in its dock node)
+    bool skipGuiWhenHidden = false;
 };
 // @@md
 
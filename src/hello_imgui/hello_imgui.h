@@ -182,6 +182,116 @@ bool IsUsingHelloImGui();
 //  (Will only lead to accurate values if you call it at each frame)
 float FrameRate(float durationForMean = 0.5f);
 
+// `FrameStats`: statistics on the durations of the last frames (up to 512 frames).
+//  Durations are in seconds. They are measured between the starts of two consecutive
+//  frames, and thus include the time spent idling.
+struct FrameStats
+{
+    int    nbFrames = 0;
+    double minFrameTime = 0.;
+    double maxFrameTime = 0.;
+    double meanFrameTime = 0.;
+    double p50FrameTime = 0.;
+    double p95FrameTime = 0.;
+    double p99FrameTime = 0.;
+    // Number of frames whose duration exceeded the frame budget ("jank")
+    int    nbJankFrames = 0;
+};
+
+// `GetFrameStats(frameBudget = 1/60.)`: returns statistics on the last frames.
+//  Frames longer than frameBudget (in seconds) are counted in nbJankFrames.
+//  This function does not allocate, and may be called at each frame.
+FrameStats GetFrameStats(double frameBudget = 1. / 60.);
+
+// `FramePhase`: the successive phases of a frame inside HelloImGui's main loop,
+//  as measured by the frame profiler.
+enum class FramePhase
+{
+    HandleLayout,   // Layout changes, tests registration, window size & position
+    HandleIdling,   // Idling (includes the time spent sleeping while idle)
+    PollEvents,     // Platform events, fonts loading, PreNewFrame callback
+    NewFrame,       // Backends NewFrame, ImGui::NewFrame, CustomBackground callback
+    RenderGui,      // Gui: ShowGui, dockable windows, menus, status bar, BeforeImGuiRender callback
+    RenderAndSwap,  // ImGui::Render, draw data rendering, additional viewports, SwapBuffers
+    AfterSwap,      // AfterSwap callback, test engine
+    Count
+};
+
+// `FramePhaseName(phase)`: returns a short display name for a frame phase
+const char* FramePhaseName(FramePhase phase);
+
+// `FramePhaseTimings`: the durations (in seconds) of each phase of a given frame
+struct FramePhaseTimings
+{
+    double frameStartTime = 0.;  // in seconds, since the application start
+    double phaseDurations[(int)FramePhase::Count] = {};
+
+    double TotalDuration() const;
+};
+
+// `FramePhaseTimingsHistory(maxFrames = 120)`: returns the phase timings of the last
+//  rendered frames (oldest first).
+//  The frame profiler is opt-in: it only records frames when
+//  runnerParams.enableFrameProfiler (or imGuiWindowParams.showStatus_FrameProfiler) is true.
+//  Up to 512 frames are kept.
+std::vector<FramePhaseTimings> FramePhaseTimingsHistory(int maxFrames = 120);
+
+// `StartupPhase`: the successive phases of HelloImGui's startup (before the first frame)
+enum class StartupPhase
+{
+    InitImGuiContext,     // ImGui context creation
+    InitPlatformBackend,  // Platform backend (SDL, Glfw) initialization
+    CreateWindow,         // Window geometry, and window creation
+    InitRenderer,         // Rendering context (e.g. OpenGL context & loader), window icon
+    SetupDpi,             // DPI aware params, window size adjustment
+    PostInit,             // Backends linking, PostInit & SetupImGuiConfig callbacks
+    LoadFonts,            // LoadAdditionalFonts callback
+    LoadSettings,         // Docking configuration, application settings
+    ApplyTheme,           // Theme, SetupImGuiStyle callback
+    Finalize,             // Remote display, trace export, input recording (and end of the prefetch)
+    Count
+};
+
+// `StartupPhaseName(phase)`: returns a short display name for a startup phase
+const char* StartupPhaseName(StartupPhase phase);
+
+// `StartupTimings`: the durations (in seconds) of each startup phase.
+//  While the window and the rendering context are being created, worker threads prefetch
+//  the settings files and the assets needed by the startup (see RunnerParams.startupPrefetch):
+//  prefetchDuration is the duration of this work (which overlaps the startup phases).
+struct StartupTimings
+{
+    double startupStartTime = 0.;  // in seconds, since the application start
+    double phaseDurations[(int)StartupPhase::Count] = {};
+    double prefetchDuration = 0.;
+
+    double TotalDuration() const;
+};
+
+// `GetStartupTimings()`: returns the startup timings of the current application
+//  (they are complete once the first frame is rendered).
+StartupTimings GetStartupTimings();
+
+// `ProfileScope`: RAII marker that measures the duration of a named scope.
+//  When runnerParams.traceExportFile is set, the scope is written to the trace file,
+//  alongside the frame phases (otherwise it costs almost nothing).
+//  It may be used from any thread. Example:
+//      void MyGui() {
+//          HelloImGui::ProfileScope scope("MyGui");
+//          ...
+//      }
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    const char* mName;
+    double mStartTime;
+};
+
 // `ImGuiTestEngine* GetImGuiTestEngine()`: returns a pointer to the global instance
 //  of ImGuiTestEngine that was initialized by HelloImGui
 //  (iif ImGui Test Engine is active).
@@ -203,6 +313,22 @@ void ChangeWindowSize(const ScreenSize &windowSize);
 // (useful if you want to change the window size during execution)
 void UseWindowFullMonitorWorkArea();
 
+// `RequestRedraw()`: wakes up the application if it is idling, so that a new frame
+//  is rendered immediately (instead of up to 1/fpsIdling.fpsIdle seconds later).
+//  It may be called from any thread, e.g. when a worker thread has produced new data
+//  that should be displayed.
+void RequestRedraw();
+
+// `RequestAnimationFrames(fps, durationSeconds)`: declares that something is animated
+//  (a spinner, a transition, a live plot...), and needs to be rendered at least at `fps`
+//  during the next `durationSeconds`, even if the application is idling.
+//  When several requests are outstanding, the application renders at the lowest frame rate
+//  that satisfies all of them (i.e. the highest requested fps), instead of running at full speed.
+//  A request for the same fps extends the previous one. It may be called from any thread.
+//  Example (inside a widget that displays a spinner):
+//      HelloImGui::RequestAnimationFrames(30.f, 0.1f);
+void RequestAnimationFrames(float fps, float durationSeconds);
+
 // @@md
 
 
@@ -1,5 +1,7 @@
 #pragma once
 #include "imgui.h"
+#include <string>
+#include <vector>
 /**
 @@md#HelloImGui::Log
 
@@ -9,6 +11,14 @@ HelloImGui provides a simple Log utility that is able to collect message and dis
 * __HelloImGui::LogClear()__ will clear the Log list
 * __HelloImGui::LogGui()__ will display the Log widget
 
+Log() can be called from any thread: it never waits for the UI thread
+(messages are staged per thread, and collected by the UI thread once per frame).
+
+Each record carries a monotonic timestamp (in seconds) and the id of the thread which logged it.
+The Log widget keeps only the most recent records (600 KB): if you need the full history,
+use __HelloImGui::LogOpenFileSink()__, which also writes the records into rotating binary files;
+LogGui() will then be able to page older records back from the disk.
+
 @@md
 */
 namespace HelloImGui
@@ -24,4 +34,41 @@ enum class LogLevel
 void Log(LogLevel level, char const* const format, ...);
 void LogClear();
 void LogGui(ImVec2 size = ImVec2(0.f, 0.f), bool minimal = false);
+
+struct LogRecord
+{
+    LogLevel level = LogLevel::Debug;
+    // seconds, since the application start (monotonic clock)
+    double timestamp = 0.;
+    // small id of the thread which logged this record (ids are given in the order in which threads first log)
+    unsigned threadId = 0;
+    std::string message;
+};
+
+struct LogFileSinkParams
+{
+    // Records are written to `filename`, then to `filename.1`, `filename.2`, ... after each rotation
+    std::string filename = "hello_imgui_log.bin";
+    // Size after which the file is rotated
+    size_t maxFileBytes = 16 * 1024 * 1024;
+    // Max number of files kept (the oldest one is deleted on rotation)
+    int maxFiles = 4;
+};
+
+// Starts writing the log records into rotating binary files (previous files with the same name are deleted).
+// Returns false if the file cannot be created.
+bool LogOpenFileSink(const LogFileSinkParams& params = LogFileSinkParams());
+void LogCloseFileSink();
+// Number of records available in the file sink
+size_t LogFileSinkNbRecords();
+// Reads a page of records from the file sink: page 0 holds the most recent records
+// (inside a page, records are ordered from the oldest to the newest)
+std::vector<LogRecord> LogFileSinkReadPage(size_t pageIndex, size_t pageSize);
+
+namespace internal
+{
+    // Log() does not lock: messages are staged per thread, and moved into the Log widget
+    // by this function, which is called once per frame by the runner (and by LogGui())
+    void DrainStagedLogRecords();
+}
 } 
@@ -1,6 +1,10 @@
 #pragma once
 #include "imgui.h"
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace HelloImGui
 {
 // @@md#HelloImGui::ImageFromAsset
@@ -58,11 +62,14 @@ ImVec2 ImageSizeFromAsset(const char *assetPath);
 
 
 // `HelloImGui::ImageAndSize HelloImGui::ImageAndSizeFromAsset(assetPath)`:
-// will return the texture ID and the size of an image loaded from the assets.
+// will return the texture ID and the size of an image loaded from the assets,
+// as well as its UV sub-rectangle inside the texture (which is not (0,0)-(1,1) if it is stored in an atlas)
 struct ImageAndSize
 {
     ImTextureID textureId = ImTextureID(0);
     ImVec2 size = ImVec2(0.f, 0.f);
+    ImVec2 uv0 = ImVec2(0.f, 0.f);
+    ImVec2 uv1 = ImVec2(1.f, 1.f);
 };
 ImageAndSize ImageAndSizeFromAsset(const char *assetPath);
 
@@ -77,10 +84,100 @@ ImageAndSize ImageAndSizeFromAsset(const char *assetPath);
 //        so you don't need to call it directly.
 ImVec2 ImageProportionalSize(const ImVec2& askedSize, const ImVec2& imageSize);
 
+
+// `ImageFromAssetParams`: options for the loading of images from the assets
+// (stored inside RunnerParams.imageFromAssetParams)
+struct ImageFromAssetParams
+{
+    // `asyncLoading`: _bool, default=false_.
+    // If true, images are read and decoded on worker threads the first time they are displayed,
+    // so that opening a panel with many images does not cause a visible hitch.
+    // Until the texture is ready, ImageFromAsset & co. draw nothing
+    // (they reserve the space if both dimensions of the size are specified),
+    // ImTextureIdFromAsset returns 0, and ImageSizeFromAsset returns (0, 0).
+    // Only the texture upload happens on the render thread, within a per-frame budget
+    // (under Android, the asset files are also read by the render thread: only the decoding is done by the workers).
+    // Note: ImageFromExternalAsset is always loaded synchronously.
+    bool asyncLoading = false;
+    // `asyncNbWorkerThreads`: _int, default=2_. Number of threads used to decode images
+    int asyncNbWorkerThreads = 2;
+    // `asyncMaxUploadsPerFrame`: _int, default=4_. Max number of textures uploaded per frame
+    int asyncMaxUploadsPerFrame = 4;
+    // `asyncMaxUploadBytesPerFrame`: _size_t, default=8MB_.
+    // Max number of bytes (width*height*4) uploaded per frame (at least one texture is uploaded per frame)
+    size_t asyncMaxUploadBytesPerFrame = 8 * 1024 * 1024;
+
+    // `textureCacheMaxBytes`: _size_t, default=0 (unlimited)_.
+    // Budget (in bytes, counted as width*height*4) for the textures kept in the cache.
+    // When it is exceeded, the least recently used images are freed at the start of the next frame
+    // (images used during the previous frame and pinned images are never freed).
+    // Note: when a budget is set, do not keep a texture ID given by ImTextureIdFromAsset
+    //       across frames, unless the image is pinned (see PinImageFromAsset)
+    // Images stored in the atlas (see atlasEnabled) are not counted, and never freed:
+    // freeing one of them would not free its page.
+    size_t textureCacheMaxBytes = 0;
+
+    // `atlasEnabled`: _bool, default=false_.
+    // If true, small images (e.g. icons) are packed into shared texture pages, so that
+    // ImGui can batch their draw calls instead of switching texture for each image.
+    // ImageFromAsset and ImageButtonFromAsset handle the UV sub-rectangle automatically;
+    // if you use ImTextureIdFromAsset, use ImageAndSizeFromAsset instead, which also returns the UVs.
+    // Note: the texture ID of a page changes when images are added to it:
+    //       do not keep it across frames.
+    bool atlasEnabled = false;
+    // `atlasMaxImageSize`: _int, default=64_.
+    // Images whose width and height are both <= atlasMaxImageSize are stored in the atlas
+    int atlasMaxImageSize = 64;
+    // `atlasPageSize`: _int, default=512_. Width and height of an atlas page (in pixels)
+    int atlasPageSize = 512;
+};
+
+
+// `ImageFromAssetCacheStats`: statistics about the cache of images loaded from the assets
+struct ImageFromAssetCacheStats
+{
+    // number of lookups which found the image in the cache
+    size_t nbHits = 0;
+    // number of lookups which had to load the image
+    size_t nbMisses = 0;
+    // number of images freed in order to respect textureCacheMaxBytes
+    size_t nbEvictions = 0;
+    // number of images currently in the cache, and the size in bytes (width*height*4)
+    // of those which are counted in textureCacheMaxBytes (i.e. not stored in the atlas)
+    size_t nbResidentImages = 0;
+    size_t residentBytes = 0;
+    // size in bytes of the atlas pages (not counted in textureCacheMaxBytes)
+    size_t atlasBytes = 0;
+};
+
+// `ImageFromAssetCacheStats HelloImGui::GetImageFromAssetCacheStats()`:
+// returns the statistics of the image cache (see ImageFromAssetParams.textureCacheMaxBytes)
+ImageFromAssetCacheStats GetImageFromAssetCacheStats();
+
+// `HelloImGui::PinImageFromAsset(assetPath, pinned=true)`:
+// a pinned image is never evicted from the cache (this applies to all the sizes of an svg image).
+// Pinning does not load the image.
+void PinImageFromAsset(const char *assetPath, bool pinned = true);
+
 // @@md
 
 namespace internal
 {
     void Free_ImageFromAssetMap();
+    // Called once per frame by the runner, before ImGui::NewFrame():
+    //   - uploads the textures of the images decoded by the worker threads (if asyncLoading is enabled)
+    //   - frees the atlas page textures replaced during the previous frame
+    //   - frees the least recently used images if the cache exceeds textureCacheMaxBytes
+    void PreNewFrame_ImageFromAssetMap();
+
+    // Used by the draw commands cache of the dockable windows, whose replayed frames reuse
+    // the texture IDs of the images without calling ImageFromAsset & co.:
+    //   - while a recorder is set, the keys of the images that are displayed are appended to it
+    //     (returns the previous recorder)
+    //   - TouchImages() marks the recorded images as used during this frame (so that they are not evicted)
+    //   - ImageTexturesGeneration() changes whenever a texture is freed or an image is loaded
+    std::vector<std::string>* SetUsedImagesRecorder(std::vector<std::string>* recorder);
+    void TouchImages(const std::vector<std::string>& keys);
+    uint64_t ImageTexturesGeneration();
 }
 }
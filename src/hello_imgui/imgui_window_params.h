@@ -94,6 +94,10 @@ struct ImGuiWindowParams
 
     // If set, display the FPS in the status bar.
     bool showStatus_Fps = true;
+    // If set, display a timeline of the last frames in the status bar,
+    // where each frame is split into its phases (layout, idling, events, NewFrame, Gui, rendering, AfterSwap).
+    // (this enables the frame profiler, see RunnerParams.enableFrameProfiler)
+    bool showStatus_FrameProfiler = false;
     // If set, showStatusBar and showStatus_Fps are stored in the application settings.
     bool rememberStatusBarSettings = true;
 
@@ -1,12 +1,12 @@
 #include "hello_imgui/hello_imgui.h"
 #include "hello_imgui/internal/backend_impls/runner_factory.h"
+#include "hello_imgui/internal/clock_seconds.h"
 #include "hello_imgui/internal/context.h"
 #include "hello_imgui/internal/docking_details.h"
+#include "hello_imgui/internal/frame_stats_ring.h"
 #include "hello_imgui/internal/menu_statusbar.h"
 #include "imgui_internal.h"
-#include <chrono>
 #include <cstdio>
-#include <deque>
 #include <optional>
 #include <set>
 
@@ -307,70 +307,21 @@ std::string GlslVersion()
 }
 
 
-namespace ChronoShenanigans
-{
-    class ClockSeconds_
-    {
-       private:
-        using Clock = std::chrono::high_resolution_clock;
-        using second = std::chrono::duration<float, std::ratio<1>>;
-        std::chrono::time_point<Clock> mStart;
-
-       public:
-        ClockSeconds_() : mStart(Clock::now()) {}
-
-        float elapsed() const
-        {
-            return std::chrono::duration_cast<second>
-                (Clock::now() - mStart).count();
-        }
-    };
-
-    float ClockSeconds()
-    {
-        static ClockSeconds_ watch;
-        return watch.elapsed();
-    }
-
-}
-
-static std::deque<float> gFrameTimes;
+static FrameStatsRing gFrameStatsRing;
 
 void _UpdateFrameRateStats()
 {
-    float now = ChronoShenanigans::ClockSeconds();
-    gFrameTimes.push_back(now);
-
-    size_t maxFrameCount = 300;
-    while (gFrameTimes.size() > maxFrameCount)
-        gFrameTimes.pop_front();
-};
+    gFrameStatsRing.AddFrame(Internal::ClockSeconds());
+}
 
 float FrameRate(float durationForMean)
 {
-    if (gFrameTimes.size() <= 1)
-        return 0.f;
-
-    float lastFrameTime = gFrameTimes.back();
-    int lastFrameIdx = (int)gFrameTimes.size() - 1;
+    return gFrameStatsRing.FrameRate((double)durationForMean);
+}
 
-    // Go back in frame times to find the first frame that is not too old
-    int i = (int)gFrameTimes.size() - 1;
-    while (i > 0)
-    {
-        if (lastFrameTime - gFrameTimes[i] > durationForMean)
-            break;
-        --i;
-    }
-    if (i == lastFrameIdx)
-        return 0.f;
-    // printf("i=%d, lastFrameIdx=%d\n", i, lastFrameIdx);
-
-    // Compute the mean frame rate
-    float totalTime = lastFrameTime - gFrameTimes[i];
-    int nbFrames = lastFrameIdx - i;
-    float fps =  (float)nbFrames / totalTime;
-    return fps;
+FrameStats GetFrameStats(double frameBudget)
+{
+    return gFrameStatsRing.Stats(frameBudget);
 }
 
 std::string PlatformBackendTypeToString(PlatformBackendType platformBackendType)
@@ -436,6 +387,18 @@ void UseWindowFullMonitorWorkArea()
 }
 
 
+void RequestRedraw()
+{
+    // Thread-safe, and valid even if no runner is active
+    AbstractRunner::RequestRedraw();
+}
+
+void RequestAnimationFrames(float fps, float durationSeconds)
+{
+    AbstractRunner::RequestAnimationFrames(fps, durationSeconds);
+}
+
+
 bool ShouldRemoteDisplay()
 {
     return gLastRunner->ShouldRemoteDisplay();
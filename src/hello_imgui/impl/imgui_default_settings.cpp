@@ -3,19 +3,48 @@
 #include "hello_imgui/hello_imgui_assets.h"
 #include "hello_imgui/hello_imgui_font.h"
 
+#include <string>
+#include <vector>
+
 namespace HelloImGui
 {
 
 namespace ImGuiDefaultSettings
 {
 
+    static const char* kDefaultFontFile = "fonts/jetbrains.ttf";
+
+    static std::string DefaultIconFontFile(HelloImGui::DefaultIconFont defaultIconFont)
+    {
+        if (defaultIconFont == HelloImGui::DefaultIconFont::FontAwesome4)
+            return "fonts/fontawesome-webfont.ttf";
+        else if (defaultIconFont == HelloImGui::DefaultIconFont::FontAwesome6)
+            return "fonts/Font_Awesome_6_Free-Solid-900.otf";
+        else if (defaultIconFont == HelloImGui::DefaultIconFont::VsCodeIcons)
+            return "fonts/vscode-codicons.ttf";
+        else if (defaultIconFont == HelloImGui::DefaultIconFont::MaterialDesignIcons)
+            return "fonts/MaterialDesignIcons-Regular.ttf";
+        else
+            return "";
+    }
+
+    // The assets read by LoadDefaultFont_WithFontAwesomeIcons (used to prefetch them during startup)
+    std::vector<std::string> DefaultFontAssetFiles(HelloImGui::DefaultIconFont defaultIconFont)
+    {
+        std::vector<std::string> r = { kDefaultFontFile };
+        std::string iconFontFile = DefaultIconFontFile(defaultIconFont);
+        if (!iconFontFile.empty())
+            r.push_back(iconFontFile);
+        return r;
+    }
+
     void LoadDefaultFont_WithFontAwesomeIcons()
     {
         auto runnerParams = HelloImGui::GetRunnerParams();
         auto defaultIconFont = runnerParams->callbacks.defaultIconFont;
         float fontSize = 24.f;
 
-        std::string fontFilename = "fonts/jetbrains.ttf";
+        std::string fontFilename = kDefaultFontFile;
 
         if (!HelloImGui::AssetExists(fontFilename))
         {
@@ -28,21 +57,12 @@ namespace ImGuiDefaultSettings
         if (defaultIconFont == HelloImGui::DefaultIconFont::NoIcons)
             return;
 
-        std::string iconFontFile;
+        std::string iconFontFile = DefaultIconFontFile(defaultIconFont);
+        if (iconFontFile.empty())
+            return;
         HelloImGui::FontLoadingParams fontParams;
-        if (defaultIconFont == HelloImGui::DefaultIconFont::FontAwesome4)
-            iconFontFile = "fonts/fontawesome-webfont.ttf";
-        else if (defaultIconFont == HelloImGui::DefaultIconFont::FontAwesome6)
-            iconFontFile = "fonts/Font_Awesome_6_Free-Solid-900.otf";
-        else if (defaultIconFont == HelloImGui::DefaultIconFont::VsCodeIcons)
-        {
-            iconFontFile = "fonts/vscode-codicons.ttf";
+        if (defaultIconFont == HelloImGui::DefaultIconFont::VsCodeIcons)
             fontParams.fontConfig.GlyphOffset = ImVec2(1, 4.2);
-        }
-        else if (defaultIconFont == HelloImGui::DefaultIconFont::MaterialDesignIcons)
-            iconFontFile = "fonts/MaterialDesignIcons-Regular.ttf";
-        else
-            return;
 
         if (!HelloImGui::AssetExists(iconFontFile))
             return;
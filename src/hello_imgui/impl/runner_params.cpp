@@ -1,4 +1,5 @@
 #include "hello_imgui/runner_params.h"
+#include "hello_imgui/internal/hello_imgui_ini_settings.h"
 
 #include <filesystem>
 
@@ -88,6 +89,9 @@ namespace HelloImGui
         if (iniFullFilename.empty())
             return;
 
+        // Drop the cached settings, so that they are not written again
+        HelloImGuiIniSettings::ForgetIniPartsCache(iniFullFilename);
+
         if (!std::filesystem::exists(iniFullFilename))
             return;
 
@@ -103,6 +107,8 @@ namespace HelloImGui
         if (iniFullFilename.empty())
             return false;
 
+        // Settings may not have been written yet
+        HelloImGuiIniSettings::FlushIniPartsCache();
         return std::filesystem::exists(iniFullFilename);
     }
 
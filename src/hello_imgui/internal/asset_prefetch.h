@@ -0,0 +1,29 @@
+#pragma once
+#include "hello_imgui/hello_imgui_assets.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    // AssetPrefetch reads asset files on a worker thread during startup:
+    // the next LoadAssetFileData(assetPath) call returns the prefetched data instead of reading the file
+    // (and waits for it, if it is still being read).
+    // Prefetched assets are only used while LoadAssetFileData is not redirected (see SetLoadAssetFileDataFunction),
+    // and while the assets folder is the one that was used to find them (see SetAssetsFolder).
+    namespace AssetPrefetch
+    {
+        // Registers the assets which will be prefetched, and resolves their full paths
+        // (to be called by the main thread, before starting the worker thread).
+        // Does nothing if LoadAssetFileData is redirected.
+        void MarkPending(const std::vector<std::string>& assetPaths);
+        // Reads the pending assets (to be called by the worker thread)
+        void LoadPending();
+        // Returns a prefetched asset and forgets it (the caller shall free it with FreeAssetFileData)
+        std::optional<AssetFileData> Take(const std::string& assetPath);
+        // Frees the prefetched assets which were not used (the worker thread shall be finished)
+        void Clear();
+    }
+}
@@ -3,12 +3,18 @@
 #include "hello_imgui/internal/borderless_movable.h"
 #include "hello_imgui/internal/clock_seconds.h"
 #include "hello_imgui/internal/docking_details.h"
+#include "hello_imgui/internal/draw_data_hash.h"
+#include "hello_imgui/internal/frame_profiler.h"
+#include "hello_imgui/internal/gui_cost_profiler.h"
+#include "hello_imgui/internal/trace_exporter.h"
+#include "hello_imgui/internal/input_recorder.h"
 #include "hello_imgui/internal/hello_imgui_ini_settings.h"
 #include "hello_imgui/internal/hello_imgui_ini_any_parent_folder.h"
 #include "hello_imgui/internal/menu_statusbar.h"
 #include "hello_imgui/internal/platform/ini_folder_locations.h"
 #include "hello_imgui/internal/inicpp.h"
 #include "hello_imgui/internal/poor_man_log.h"
+#include "hello_imgui/internal/startup_pipeline.h"
 #include "imgui.h"
 
 #include "hello_imgui/internal/imgui_global_context.h" // must be included before imgui_internal.h
@@ -23,11 +29,15 @@
 #define SCOPED_RELEASE_GIL_ON_MAIN_THREAD
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cassert>
 #include <filesystem>
 #include <cstdio>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #if __APPLE__
 #include <TargetConditionals.h>
@@ -102,6 +112,13 @@ struct AbstractRunnerStatics
     bool lastHiddenState = false;
     double timeLastEvent = -1.;
     double lastRefreshTime = 0.;
+    double lastIdleWakeUpTime = 0.;
+
+    // When rendererBackendOptions.skipUnchangedFrames is set: hash of the last rendered draw data,
+    // and whether the clear color is deferred until we know if the frame is rendered
+    bool hasLastDrawDataHash = false;
+    uint64_t lastDrawDataHash = 0;
+    bool isClearColorDeferred = false;
 };
 
 static AbstractRunnerStatics gStatics;
@@ -109,6 +126,91 @@ static AbstractRunnerStatics gStatics;
 static void ResetAbstractRunnerStatics() { gStatics = AbstractRunnerStatics(); }
 
 
+// RequestRedraw() may be called from any thread, while the runner is being set up or torn down:
+// the window helper is only reachable between Setup() and TearDown(), under wakeUpTargetMutex
+struct RedrawRequestStatics
+{
+    std::atomic<bool> isRedrawRequested{false};
+    std::mutex wakeUpTargetMutex;
+    BackendApi::IBackendWindowHelper* wakeUpTarget = nullptr;
+};
+
+static RedrawRequestStatics gRedrawRequestStatics;
+
+void AbstractRunner::RequestRedraw()
+{
+    gRedrawRequestStatics.isRedrawRequested = true;
+    std::lock_guard<std::mutex> lock(gRedrawRequestStatics.wakeUpTargetMutex);
+    if (gRedrawRequestStatics.wakeUpTarget != nullptr)
+        gRedrawRequestStatics.wakeUpTarget->PostEmptyEvent();
+}
+
+static void SetRedrawWakeUpTarget(BackendApi::IBackendWindowHelper* wakeUpTarget)
+{
+    std::lock_guard<std::mutex> lock(gRedrawRequestStatics.wakeUpTargetMutex);
+    gRedrawRequestStatics.wakeUpTarget = wakeUpTarget;
+}
+
+
+// Outstanding RequestAnimationFrames() requests: at most one per distinct fps (the one which ends last)
+struct AnimationRequest
+{
+    float fps;
+    double endTime;
+};
+
+struct AnimationRequestStatics
+{
+    std::mutex mutex;
+    std::vector<AnimationRequest> requests;
+};
+
+static AnimationRequestStatics gAnimationRequestStatics;
+
+// Removes the expired requests, and returns the highest requested fps (0 if no request is active).
+// (shall be called with gAnimationRequestStatics.mutex locked)
+static float PruneAnimationRequests_Locked(double now)
+{
+    auto& requests = gAnimationRequestStatics.requests;
+    requests.erase(
+        std::remove_if(requests.begin(), requests.end(), [now](const AnimationRequest& r) { return r.endTime <= now; }),
+        requests.end());
+    float maxFps = 0.f;
+    for (const auto& r : requests)
+        maxFps = std::max(maxFps, r.fps);
+    return maxFps;
+}
+
+void AbstractRunner::RequestAnimationFrames(float fps, float durationSeconds)
+{
+    if (fps <= 0.f || durationSeconds <= 0.f)
+        return;
+    double now = Internal::ClockSeconds();
+    double endTime = now + (double)durationSeconds;
+    bool raisesFps;
+    {
+        std::lock_guard<std::mutex> lock(gAnimationRequestStatics.mutex);
+        raisesFps = fps > PruneAnimationRequests_Locked(now);
+        auto& requests = gAnimationRequestStatics.requests;
+        auto it = std::find_if(requests.begin(), requests.end(), [fps](const AnimationRequest& r) { return r.fps == fps; });
+        if (it == requests.end())
+            requests.push_back({fps, endTime});
+        else
+            it->endTime = std::max(it->endTime, endTime);
+    }
+    // If the app is idling at a lower rate, wake it up so that the new rate applies immediately
+    if (raisesFps)
+        RequestRedraw();
+}
+
+// The lowest frame rate that satisfies all the outstanding animation requests (0 if none)
+static float RequiredAnimationFps()
+{
+    std::lock_guard<std::mutex> lock(gAnimationRequestStatics.mutex);
+    return PruneAnimationRequests_Locked(Internal::ClockSeconds());
+}
+
+
 
 AbstractRunner::AbstractRunner(RunnerParams &params_)
 : params(params_) {}
@@ -606,11 +708,16 @@ void AbstractRunner::InitRenderBackendCallbacks()
 void AbstractRunner::Setup()
 {
     auto& self = *this;
+    StartupPipeline::BeginStartup();
     InitRenderBackendCallbacks();
 
     InitImGuiContext();
     CheckPrefs();
 
+    // Settings files and assets are read by worker threads, while the window and the rendering context are created
+    StartupPipeline::StartPrefetch(params);
+    StartupPipeline::EndPhase(StartupPhase::InitImGuiContext);
+
     // Init platform backend (SDL, Glfw)
     Impl_InitPlatformBackend();
 
@@ -618,6 +725,7 @@ void AbstractRunner::Setup()
         if (params.rendererBackendType == RendererBackendType::OpenGL3)
             Impl_Select_Gl_Version();
     #endif
+    StartupPipeline::EndPhase(StartupPhase::InitPlatformBackend);
 
     PrepareWindowGeometry();
 
@@ -635,6 +743,7 @@ void AbstractRunner::Setup()
     };
 
     Impl_CreateWindow(fnRenderCallbackDuringResize);
+    StartupPipeline::EndPhase(StartupPhase::CreateWindow);
 
     #ifdef HELLOIMGUI_HAS_OPENGL
         if (params.rendererBackendType == RendererBackendType::OpenGL3)
@@ -645,11 +754,13 @@ void AbstractRunner::Setup()
     #endif
 
     Impl_SetWindowIcon();
+    StartupPipeline::EndPhase(StartupPhase::InitRenderer);
 
     // The order is important: first read the DPI aware params
     SetupDpiAwareParams();
     // Then adjust window size if needed
     AdjustWindowBoundsAfterCreation_IfDpiChangedBetweenRuns();
+    StartupPipeline::EndPhase(StartupPhase::SetupDpi);
 
 
     // This should be done before Impl_LinkPlatformAndRenderBackends()
@@ -670,6 +781,7 @@ void AbstractRunner::Setup()
         if (params.useImGuiTestEngine)
             TestEngineCallbacks::Setup();
     #endif
+    StartupPipeline::EndPhase(StartupPhase::PostInit);
 
     //
     // load fonts & set ImGui::GetIO().FontGlobalScale
@@ -680,10 +792,12 @@ void AbstractRunner::Setup()
     ImGui::GetIO().Fonts->Clear();
     params.callbacks.LoadAdditionalFonts();
     params.callbacks.LoadAdditionalFonts = nullptr;
+    StartupPipeline::EndPhase(StartupPhase::LoadFonts);
 
     DockingDetails::ConfigureImGuiDocking(params.imGuiWindowParams);
     HelloImGuiIniSettings::LoadHelloImGuiMiscSettings(IniSettingsLocation(params), &params);
     SetLayoutResetIfNeeded();
+    StartupPipeline::EndPhase(StartupPhase::LoadSettings);
 
     ImGuiTheme::ApplyTweakedTheme(params.imGuiWindowParams.tweakedTheme);
 
@@ -696,11 +810,29 @@ void AbstractRunner::Setup()
         style.Colors[ImGuiCol_TitleBgCollapsed].w = 1.f;
     }
     params.callbacks.SetupImGuiStyle();
+    StartupPipeline::EndPhase(StartupPhase::ApplyTheme);
 
     // Create a remote display handler if needed
     mRemoteDisplayHandler.Create();
     mRemoteDisplayHandler.SendFonts();
 
+    if (!params.traceExportFile.empty())
+        TraceExporter::Start(params.traceExportFile, params.traceExportFlushInterval);
+    if (!params.inputReplayFile.empty())
+    {
+        // A replay runs as fast as possible: idling would only add sleeps between the recorded frames
+        if (InputRecorder::StartReplay(params.inputReplayFile, params.inputReplayFixedTimestep))
+            params.fpsIdling.enableIdling = false;
+    }
+    else if (!params.inputRecordFile.empty())
+        InputRecorder::StartRecording(params.inputRecordFile);
+
+    SetRedrawWakeUpTarget(mBackendWindowHelper.get());
+
+    StartupPipeline::FinishPrefetch();
+    StartupPipeline::EndPhase(StartupPhase::Finalize);
+    StartupPipeline::EndStartup();
+
     mIdxFrame = 0;
 }
 
@@ -725,6 +857,8 @@ void AbstractRunner::SetLayoutResetIfNeeded()
 
 void AbstractRunner::RenderGui()
 {
+    GuiCostProfiler::BeginFrame();
+
     DockingDetails::ShowToolbars(params);
     if (params.imGuiWindowParams.showMenuBar)
         Menu_StatusBar::ShowMenu(params);
@@ -757,7 +891,10 @@ void AbstractRunner::RenderGui()
         if (wantAutoSize)
             ImGui::BeginGroup();
 
-        params.callbacks.ShowGui();
+        {
+            GuiCostScope guiCostScope("[ShowGui]", GuiCostKind::Callback);
+            params.callbacks.ShowGui();
+        }
 
         if (wantAutoSize)
         {
@@ -775,11 +912,17 @@ void AbstractRunner::RenderGui()
         Menu_StatusBar::ShowStatusBar(params);
 
     ShowThemeTweakGuiWindow_Static();
+    GuiCostProfiler::ShowPanel();
 
     if (params.callbacks.PostRenderDockableWindows)
+    {
+        GuiCostScope guiCostScope("[PostRenderDockableWindows]", GuiCostKind::Callback);
         params.callbacks.PostRenderDockableWindows();
+    }
 
     DockingDetails::CloseWindowOrDock(params.imGuiWindowParams);
+
+    GuiCostProfiler::EndFrame();
 }
 
 
@@ -947,16 +1090,18 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
     //  - idling is enabled
     // - no recent event was received, and the app is not in the first frames
     // - no test running
-    // - not in remote display mode
+    // - no redraw was requested (see RequestRedraw())
+    // In remote display mode, "idling" paces the frames at the rate the remote viewers poll them (see fnIdleFps)
     auto fnCanIdle = [this]() -> bool
     {
         double now = Internal::ClockSeconds();
         assert(params.fpsIdling.fpsIdle >= 0.f && "fpsIdle must be >= 0");
+        bool isRemoteDisplay = ShouldRemoteDisplay();
 
-        // If the last event is recent, do not idle
-        bool hasRecentEvent = (now - gStatics.timeLastEvent) < (double)params.fpsIdling.timeActiveAfterLastEvent;
+        // If the last event is recent, do not idle (except in remote display mode, where events come from the viewers)
+        bool hasRecentEvent = !isRemoteDisplay && (now - gStatics.timeLastEvent) < (double)params.fpsIdling.timeActiveAfterLastEvent;
         // If idling is disabled by params, do not idle
-        bool isIdlingDisabledByParams = (! params.fpsIdling.enableIdling || (params.fpsIdling.fpsIdle <= 0.f) );
+        bool isIdlingDisabledByParams = (! params.fpsIdling.enableIdling || (!isRemoteDisplay && params.fpsIdling.fpsIdle <= 0.f) );
 
         // If the test engine is running, do not idle
         bool isTestEngineRunning = false;
@@ -970,36 +1115,56 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
         // If the app started recently, do not idle
         bool startedRecently = mIdxFrame < 12;
 
-        bool preventIdling = isIdlingDisabledByParams || hasRecentEvent || isTestEngineRunning || ShouldRemoteDisplay() || startedRecently;
+        // If a redraw was requested (by any thread) since the last frame, do not idle
+        bool isRedrawRequested = gRedrawRequestStatics.isRedrawRequested.exchange(false);
+
+        bool preventIdling = isIdlingDisabledByParams || hasRecentEvent || isTestEngineRunning || startedRecently || isRedrawRequested;
         return ! preventIdling;
     };
 
 
+    // The frame rate while idling: fpsIdle, or more if animations requested it (see RequestAnimationFrames).
+    // In remote display mode: the rate at which the viewers poll frames (see RemoteParams.fpsRemoteMax)
+    auto fnIdleFps = [this]() -> float
+    {
+        if (ShouldRemoteDisplay())
+            return mRemoteDisplayHandler.ProduceFps();
+        return std::max(params.fpsIdling.fpsIdle, RequiredAnimationFps());
+    };
+
     // Handle idling by sleeping (all platforms except emscripten)
-    auto fnIdleBySleeping = [this]()
+    auto fnIdleBySleeping = [this](float idleFps)
     {
         // Idling for non emscripten, where HelloImGui is responsible for the main loop.
         // This form of idling will call WaitForEventTimeout(), which may call sleep():
-        double waitTimeout = 1. / (double) params.fpsIdling.fpsIdle;
-        mBackendWindowHelper->WaitForEventTimeout(waitTimeout);
+        // we wait until one period after the previous wake-up, so that the frame duration
+        // is included in the period (otherwise an animation requested at 30 fps would run slower)
+        double period = 1. / (double) idleFps;
+        double elapsed = Internal::ClockSeconds() - gStatics.lastIdleWakeUpTime;
+        double waitTimeout = period - elapsed;
+        if (waitTimeout > 0.)
+            mBackendWindowHelper->WaitForEventTimeout(waitTimeout);
+        // The frame that follows will honor the redraw requests received while waiting
+        gRedrawRequestStatics.isRedrawRequested = false;
     };
 
 
-    auto fnWasLastFrameRenderedInTimeForDesiredFps = [this]() -> bool
+    auto fnWasLastFrameRenderedInTimeForDesiredFps = [](float idleFps) -> bool
     {
         double now = Internal::ClockSeconds();
-        bool wasLastFrameRenderedInTimeForDesiredFps = ((now - gStatics.lastRefreshTime) < 1. / params.fpsIdling.fpsIdle);
+        bool wasLastFrameRenderedInTimeForDesiredFps = ((now - gStatics.lastRefreshTime) < 1. / idleFps);
         return wasLastFrameRenderedInTimeForDesiredFps;
     };
 
     // Handles idling, and returns true if we should skip rendering this frame
     // (Idling is handled by sleeping on all platforms except emscripten, where we skip rendering)
-    auto fnHandleIdling = [this, fnCanIdle, fnIdleBySleeping, fnWasLastFrameRenderedInTimeForDesiredFps]() -> bool
+    auto fnHandleIdling = [this, fnCanIdle, fnIdleFps, fnIdleBySleeping, fnWasLastFrameRenderedInTimeForDesiredFps]() -> bool
     {
         bool shallIdle = fnCanIdle();
         params.fpsIdling.isIdling = shallIdle;
         if (shallIdle)
         {
+            float idleFps = fnIdleFps();
             bool idleByEarlyReturn = false;
 
             if (params.fpsIdling.fpsIdlingMode == FpsIdlingMode::EarlyReturn)
@@ -1017,15 +1182,16 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
 
             if (idleByEarlyReturn)
             {
-                if (fnWasLastFrameRenderedInTimeForDesiredFps())
+                if (fnWasLastFrameRenderedInTimeForDesiredFps(idleFps))
                     return true;
             }
             else
             {
                 // Handle idling by sleeping (all platforms except emscripten)
-                fnIdleBySleeping();
+                fnIdleBySleeping(idleFps);
             }
         }
+        gStatics.lastIdleWakeUpTime = Internal::ClockSeconds();
         return false;
     };
 
@@ -1124,21 +1290,69 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
         // CustomBackground is a user callback
         if (params.callbacks.CustomBackground)
             params.callbacks.CustomBackground();
+        else if (params.rendererBackendOptions.skipUnchangedFrames)
+            gStatics.isClearColorDeferred = true; // the frame may not be rendered: see fnRenderAndSwap
         else
             mRenderingBackendCallbacks->Impl_Frame_3D_ClearColor(params.imGuiWindowParams.backgroundColor);
     };
 
+    // Returns true if the draw data is identical to the one of the last rendered frame
+    // (only when rendererBackendOptions.skipUnchangedFrames is set)
+    auto fnIsDrawDataUnchanged = [this]() -> bool
+    {
+        bool canSkip = params.rendererBackendOptions.skipUnchangedFrames && !params.callbacks.CustomBackground;
+        uint64_t hash = 0;
+        if (!canSkip || !ComputeDrawDataHash(ImGui::GetDrawData(), params.imGuiWindowParams.backgroundColor, &hash))
+        {
+            gStatics.hasLastDrawDataHash = false;
+            return false;
+        }
+        bool isUnchanged = gStatics.hasLastDrawDataHash && (hash == gStatics.lastDrawDataHash);
+        gStatics.hasLastDrawDataHash = true;
+        gStatics.lastDrawDataHash = hash;
+        return isUnchanged;
+    };
+
+    // When a frame is not swapped, nothing waits for the display vsync anymore:
+    // wait for the rest of a display refresh period (or until an event arrives), so that the loop does not spin
+    auto fnWaitInsteadOfSwap = [this]()
+    {
+        #ifndef __EMSCRIPTEN__
+        if (params.rendererBackendType == RendererBackendType::Null)
+            return;
+        int refreshRate = mBackendWindowHelper->GetWindowMonitorRefreshRate(mWindow);
+        double refreshPeriod = 1. / (double)(refreshRate > 0 ? refreshRate : 60);
+        double waitTimeout = refreshPeriod - (Internal::ClockSeconds() - gStatics.lastRefreshTime);
+        if (waitTimeout > 0.)
+            mBackendWindowHelper->WaitForEventTimeout(waitTimeout);
+        #endif
+    };
+
 
     // Render and Swap
-    auto fnRenderAndSwap = [this]()
+    auto fnRenderAndSwap = [this, fnIsDrawDataUnchanged, fnWaitInsteadOfSwap]()
     {
         ImGui::Render();
-        mRenderingBackendCallbacks->Impl_RenderDrawData_To_3D();
+
+        bool skipRendering = fnIsDrawDataUnchanged();
+        if (!skipRendering)
+        {
+            if (gStatics.isClearColorDeferred)
+                mRenderingBackendCallbacks->Impl_Frame_3D_ClearColor(params.imGuiWindowParams.backgroundColor);
+            mRenderingBackendCallbacks->Impl_RenderDrawData_To_3D();
+        }
+        gStatics.isClearColorDeferred = false;
 
         if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             Impl_UpdateAndRenderAdditionalPlatformWindows();
 
-        Impl_SwapBuffers();
+        if (skipRendering)
+        {
+            mRenderingBackendCallbacks->Impl_AbandonFrame_3D();
+            fnWaitInsteadOfSwap();
+        }
+        else
+            Impl_SwapBuffers();
 
         mRemoteDisplayHandler.Heartbeat_PostImGuiRender();
     };
@@ -1219,18 +1433,22 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
     //                                           std::function<void()> renderCallbackDuringResize) = 0;
     // Where renderCallbackDuringResize is set to CreateFramesAndRender(skipPollEvents=true)
 
+    // The frame profiler measures the successive phases of this frame
+    // (reentrant calls are not measured, since they happen inside the PollEvents phase of the outer frame)
+    bool shallProfileFrame =
+        (params.enableFrameProfiler || params.imGuiWindowParams.showStatus_FrameProfiler || TraceExporter::IsActive())
+        && !insideReentrantCall;
+    auto fnProfilerEndPhase = [shallProfileFrame](FramePhase phase)
+    {
+        if (shallProfileFrame)
+            FrameProfiler::EndPhase(phase);
+    };
+    if (shallProfileFrame)
+        FrameProfiler::BeginFrame();
+
     // Will display on remote server if needed
     mRemoteDisplayHandler.Heartbeat_PreImGuiNewFrame();
 
-    if (ShouldRemoteDisplay()) // FIXME, unrelated
-    {
-        // if displaying remote, the FPS is limited on the server to a value between 30 and 60 fps
-        // We cannot idle too slow, other the GUI becomes really sluggish
-        // Ideally, we should ask the server about it current refresh rate
-        // (At the moment, we can only deliver 30fps)
-        params.fpsIdling.fpsIdle = 30.f;
-    }
-
     {
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
         fnHandleLayout();
@@ -1242,6 +1460,7 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
         fnHandleWindowSizeAndPositionOnFirstFrames_AndAfterResize();
     }
+    fnProfilerEndPhase(FramePhase::HandleLayout);
 
     // nbEventsBeforePollAndIdle enables us to detect if an event was received
     int nbEventsBeforePollAndIdle = ImGui::GetCurrentContext()->InputEventsQueue.size();
@@ -1251,8 +1470,13 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
         bool shallSkipRenderingThisFrame = fnHandleIdling();
         if (shallSkipRenderingThisFrame)
+        {
+            if (shallProfileFrame)
+                FrameProfiler::CancelFrame();
             return;
+        }
     }
+    fnProfilerEndPhase(FramePhase::HandleIdling);
 
     // Handle poll events
     // Warning: Due to severe gotcha inside GLFW and SDL: PollEvent is supposed to return immediately,
@@ -1282,12 +1506,21 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
 
     if ((params.callbacks.PreNewFrame) && !insideReentrantCall)
         params.callbacks.PreNewFrame();
+    fnProfilerEndPhase(FramePhase::PollEvents);
 
     {
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
         fnNewFrameRenderingAndPlatformBackend();
     }
 
+    // Upload the images that were decoded asynchronously, and free the least recently used ones
+    // if the cache is over budget (see ImageFromAssetParams)
+    HelloImGui::internal::PreNewFrame_ImageFromAssetMap();
+    // Collect the log messages sent by all threads since the last frame
+    HelloImGui::internal::DrainStagedLogRecords();
+    // Record the inputs of this frame, or replace them by the recorded ones
+    InputRecorder::OnPreImGuiNewFrame();
+
     // ImGui::NewFrame may call ImGuiTestEngine_PostNewFrame, which in turn handles the GIL in its own way,
     // so that it can *NOT* be called inside SCOPED_RELEASE_GIL_ON_MAIN_THREAD
     ImGui::NewFrame();
@@ -1297,6 +1530,7 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
 
         fnDrawCustomBackgroundOrClearColor_UserCallback(); // User callback
     }
+    fnProfilerEndPhase(FramePhase::NewFrame);
 
     // Handle AddDockableWindow(): this call should be done when ImGui is accepting widgets
     if (mIdxFrame > 3)
@@ -1310,11 +1544,13 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
 
     if (params.callbacks.BeforeImGuiRender)
         params.callbacks.BeforeImGuiRender();
+    fnProfilerEndPhase(FramePhase::RenderGui);
 
     {
         SCOPED_RELEASE_GIL_ON_MAIN_THREAD;
         fnRenderAndSwap();
     }
+    fnProfilerEndPhase(FramePhase::RenderAndSwap);
 
     // AfterSwap is a user callback, so it should not be inside SCOPED_RELEASE_GIL_ON_MAIN_THREAD
     if (params.callbacks.AfterSwap)
@@ -1323,7 +1559,13 @@ void AbstractRunner::CreateFramesAndRender(bool insideReentrantCall)
     // TestEngineCallbacks::PostSwap() handles the GIL in its own way,
     // it can not be called inside SCOPED_RELEASE_GIL_ON_MAIN_THREAD
     fnCallTestEngineCallbackPostSwap();
+    fnProfilerEndPhase(FramePhase::AfterSwap);
+    if (shallProfileFrame)
+        FrameProfiler::EndFrame();
+    TraceExporter::FlushIfNoBackgroundThread();
 
+    if (InputRecorder::IsReplayFinished())
+        params.appShallExit = true;
     if (!mRemoteDisplayHandler.CanQuitApp())
         params.appShallExit = false;
 
@@ -1368,6 +1610,14 @@ void AbstractRunner::TearDown(bool gotException)
 {
     IM_ASSERT(!mWasTearedDown && "TearDown() called twice!");
     mWasTearedDown = true;
+    SetRedrawWakeUpTarget(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(gAnimationRequestStatics.mutex);
+        gAnimationRequestStatics.requests.clear();
+    }
+    TraceExporter::Stop();
+    InputRecorder::StopRecording();
+    InputRecorder::StopReplay();
     if (! gotException)
     {
         // Store screenshot before exiting
@@ -1383,6 +1633,8 @@ void AbstractRunner::TearDown(bool gotException)
         LayoutSettings_Save();
         HelloImGuiIniSettings::SaveHelloImGuiMiscSettings(IniSettingsLocation(params), params);
     }
+    // The settings are written by a background thread: write them now
+    HelloImGuiIniSettings::FlushIniPartsCache();
 
     HelloImGui::internal::Free_ImageFromAssetMap();
 
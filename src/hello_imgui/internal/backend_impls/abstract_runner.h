@@ -45,6 +45,11 @@ public:
     void LayoutSettings_SwitchLayout(const std::string& layoutName);
     bool ShouldRemoteDisplay();
 
+    // Wakes up the idling loop, so that a new frame is rendered immediately. May be called from any thread.
+    static void RequestRedraw();
+    // Keeps rendering at (at least) `fps` during `durationSeconds`. May be called from any thread.
+    static void RequestAnimationFrames(float fps, float durationSeconds);
+
 
     void        SaveUserPref(const std::string& userPrefName, const std::string& userPrefContent);
     std::string LoadUserPref(const std::string& userPrefName);
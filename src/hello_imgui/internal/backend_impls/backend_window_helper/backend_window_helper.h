@@ -68,6 +68,8 @@ namespace HelloImGui { namespace BackendApi
         virtual void SetWindowBounds(WindowPointer window, ScreenBounds windowBounds) = 0;
 
         virtual void WaitForEventTimeout(double timeout_seconds) = 0;
+        // Wakes up WaitForEventTimeout() immediately. May be called from any thread.
+        virtual void PostEmptyEvent() = 0;
 
         // (ImGui backends handle this by themselves)
         //virtual ImVec2 GetDisplayFramebufferScale(WindowPointer window) = 0;
@@ -76,6 +78,9 @@ namespace HelloImGui { namespace BackendApi
         // (i.e. the same size given at creation create the same physical size in mm on the screen)
         virtual float GetWindowSizeDpiScaleFactor(WindowPointer window) = 0;
 
+        // Return the refresh rate (in Hz) of the monitor which displays the window, or 0 if unknown
+        virtual int GetWindowMonitorRefreshRate(WindowPointer window) = 0;
+
         virtual void HideWindow(WindowPointer window) = 0;
         virtual void ShowWindow(WindowPointer window) = 0;
         virtual bool IsWindowHidden(WindowPointer window) = 0;
@@ -213,6 +213,42 @@ namespace HelloImGui { namespace BackendApi
         glfwWaitEventsTimeout(timeout_seconds);
     }
 
+    void GlfwWindowHelper::PostEmptyEvent()
+    {
+        glfwPostEmptyEvent(); // thread-safe
+    }
+
+    int GlfwWindowHelper::GetWindowMonitorRefreshRate(WindowPointer window)
+    {
+        // A windowed window has no monitor: search the monitor which contains the window center
+        auto glfwWindow = (GLFWwindow *)(window);
+        GLFWmonitor* windowMonitor = glfwGetWindowMonitor(glfwWindow);
+        if (windowMonitor == nullptr)
+        {
+            ScreenBounds windowBounds = GetWindowBounds(window);
+            ScreenPosition windowCenter = windowBounds.Center();
+            int nbMonitors;
+            auto monitors = glfwGetMonitors(&nbMonitors);
+            for (int i = 0; i < nbMonitors && windowMonitor == nullptr; ++i)
+            {
+                const GLFWvidmode* mode = glfwGetVideoMode(monitors[i]);
+                if (mode == nullptr)
+                    continue;
+                int x, y;
+                glfwGetMonitorPos(monitors[i], &x, &y);
+                ScreenBounds monitorBounds{{x, y}, {mode->width, mode->height}};
+                if (monitorBounds.Contains(windowCenter))
+                    windowMonitor = monitors[i];
+            }
+        }
+        if (windowMonitor == nullptr)
+            windowMonitor = glfwGetPrimaryMonitor();
+        if (windowMonitor == nullptr)
+            return 0;
+        const GLFWvidmode* mode = glfwGetVideoMode(windowMonitor);
+        return (mode != nullptr) ? mode->refreshRate : 0;
+    }
+
     ImVec2 _GetWindowContentScale(HelloImGui::BackendApi::WindowPointer window)
     {
         float x_scale, y_scale;
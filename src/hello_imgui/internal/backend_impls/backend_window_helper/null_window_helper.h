@@ -2,6 +2,9 @@
 
 #include "backend_window_helper.h"
 #include "hello_imgui/internal/backend_impls/null_config.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #ifdef _WIN32
@@ -37,10 +40,21 @@ namespace HelloImGui { namespace BackendApi
         }
 
         void WaitForEventTimeout(double timeout_seconds) override {
-            std::this_thread::sleep_for(std::chrono::milliseconds((int)(timeout_seconds * 1000)));
+            std::unique_lock<std::mutex> lock(mWakeUpMutex);
+            mWakeUpCondition.wait_for(lock, std::chrono::milliseconds((int)(timeout_seconds * 1000)),
+                                      [this] { return mWakeUpRequested; });
+            mWakeUpRequested = false;
+        }
+        void PostEmptyEvent() override {
+            {
+                std::lock_guard<std::mutex> lock(mWakeUpMutex);
+                mWakeUpRequested = true;
+            }
+            mWakeUpCondition.notify_one();
         }
 
         float GetWindowSizeDpiScaleFactor(WindowPointer window) override { return NullConfig::GetWindowSizeDpiScaleFactor(); }
+        int GetWindowMonitorRefreshRate(WindowPointer window) override { return 0; }
 
         void HideWindow(WindowPointer window) override {}
         void ShowWindow(WindowPointer window) override {}
@@ -49,5 +63,9 @@ namespace HelloImGui { namespace BackendApi
     private:
         ScreenBounds mWindowBounds = {};
 
+        std::mutex mWakeUpMutex;
+        std::condition_variable mWakeUpCondition;
+        bool mWakeUpRequested = false;
+
     };
 }} // namespace HelloImGui { namespace BackendApi
@@ -227,6 +227,28 @@ namespace HelloImGui { namespace BackendApi
         SDL_WaitEventTimeout(NULL, timeout_ms);
     }
 
+    void SdlWindowHelper::PostEmptyEvent()
+    {
+        // SDL_PushEvent is thread-safe. We use a registered event type,
+        // so that it does not collide with the application's own SDL_USEREVENT
+        static Uint32 wakeUpEventType = SDL_RegisterEvents(1);
+        if (wakeUpEventType == (Uint32)-1)
+            return;
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = wakeUpEventType;
+        SDL_PushEvent(&event);
+    }
+
+    int SdlWindowHelper::GetWindowMonitorRefreshRate(WindowPointer window)
+    {
+        auto sdlWindow = (SDL_Window *)(window);
+        SDL_DisplayMode displayMode;
+        if (SDL_GetWindowDisplayMode(sdlWindow, &displayMode) != 0)
+            return 0;
+        return displayMode.refresh_rate;  // 0 if unspecified
+    }
+
     float SdlWindowHelper::GetWindowSizeDpiScaleFactor(WindowPointer window)
     {
         #if TARGET_OS_MAC // is true for any software platform that's derived from macOS, which includes iOS, watchOS, and tvOS
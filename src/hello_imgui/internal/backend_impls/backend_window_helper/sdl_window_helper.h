@@ -38,8 +38,10 @@ namespace HelloImGui { namespace BackendApi
         void SetWindowBounds(WindowPointer window, ScreenBounds windowBounds) override;
 
         void WaitForEventTimeout(double timeout_seconds) override;
+        void PostEmptyEvent() override;
 
         float GetWindowSizeDpiScaleFactor(WindowPointer window) override;
+        int GetWindowMonitorRefreshRate(WindowPointer window) override;
 
         void HideWindow(WindowPointer window) override;
         void ShowWindow(WindowPointer window) override;
@@ -9,8 +9,14 @@
 #include "hello_imgui/hello_imgui.h"
 #include "hello_imgui/internal/poor_man_log.h"
 #include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/draw_data_hash.h"
 #include "imgui_internal.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -36,82 +42,79 @@ namespace HelloImGui
         };
 
 
+        enum class NetImguiConnectionState
+        {
+            Connecting,
+            Connected,
+            WaitingBeforeRetry,
+            Stopped
+        };
+
+        // NetImGuiWrapper handles the connection to the NetImgui server:
+        // connection, reconnection and backoff run in a background thread (see ConnectionThreadLoop),
+        // so that the frame loop only polls an atomic connection state, and keeps rendering locally
+        // at full speed while the server is not reachable.
         class NetImGuiWrapper
         {
         public:
-            NetImGuiWrapper() = default;
-            ~NetImGuiWrapper() = default;
+            NetImGuiWrapper()
+            {
+                // Copy the params used by the connection thread: it shall not access RunnerParams
+                mClientName = runnerParams().appWindowParams.windowTitle;
+                if (mClientName.empty())
+                    mClientName = "HelloImGui";
+                mServerHost = remoteParams().serverHost;
+                mServerPort = remoteParams().serverPort;
+                mReconnectDelayMin = remoteParams().reconnectDelayMin;
+                mReconnectDelayMax = ImMax(remoteParams().reconnectDelayMax, mReconnectDelayMin);
+                mStopAfterDisconnection = remoteParams().exitWhenServerDisconnected;
+
+                mTimePointConnectionEnded = HelloImGui::Internal::ClockSeconds();
+                mNetImguiRaii = std::make_unique<NetImGuiRaii>();
+                mConnectionThread = std::thread([this] { ConnectionThreadLoop(); });
+            }
 
-            void HeartBeat_PreImGuiNewFrame()
+            ~NetImGuiWrapper()
             {
-                if (mNetImguiRaii == nullptr)
                 {
-                    InitiateConnection();
-                    return;
+                    std::lock_guard<std::mutex> lock(mStopMutex);
+                    mStopRequested = true;
                 }
+                mStopCondition.notify_all();
+                if (mConnectionThread.joinable())
+                    mConnectionThread.join();
+                mNetImguiRaii.reset();
+            }
 
-                int nbConnectionsPending = mNbConnectionsTentatives - mNbConnectionsSuccess - mNbConnectionsFailures;
-                IM_ASSERT(nbConnectionsPending == 0 || nbConnectionsPending == 1);
-
-                if (nbConnectionsPending == 1)
+            void HeartBeat_PreImGuiNewFrame()
+            {
+                bool isConnected = (mState.load() == NetImguiConnectionState::Connected);
+                if (isConnected && !mWasConnected)
                 {
-                    if (NetImgui::IsConnected())
-                    {
-                        LogStatus("Connection success...\n");
-                        ++ mNbConnectionsSuccess;
-                        mLastConnectionSuccess = true;
-                    }
-                    else if (NetImgui::IsConnectionPending())
-                    {
-                        LogStatus("Connection pending...\n");
-                    }
-                    else
-                    {
-                        LogStatus("Connection failure...\n");
-                        ++ mNbConnectionsFailures;
-                        mLastConnectionSuccess = false;
-                    }
+                    LogStatus("Connection success...\n");
                 }
-                else // nbConnectionsPending == 0
+                else if (!isConnected && mWasConnected)
                 {
-                    if (mLastConnectionSuccess)
+                    mTimePointConnectionEnded = HelloImGui::Internal::ClockSeconds();
+                    if (remoteParams().exitWhenServerDisconnected)
                     {
-                        if (!NetImgui::IsConnected())
-                        {
-                            if (remoteParams().exitWhenServerDisconnected)
-                            {
-                                LogStatus("Connection lost... Exiting\n");
-                                runnerParams().appShallExit = true;
-                            }
-                            else
-                            {
-                                mTimePointConnectionEnded = HelloImGui::Internal::ClockSeconds();
-                                LogStatus("Connection lost... Reconnecting\n");
-                                InitiateConnection();
-                            }
-                        }
-                    }
-                    else // Last connection was a failure
-                    {
-                        LogStatus("Last connection was a failure... Reconnecting\n");
-                        InitiateConnection();
+                        LogStatus("Connection lost... Exiting\n");
+                        runnerParams().appShallExit = true;
                     }
+                    else
+                        LogStatus("Connection lost... Reconnecting\n");
                 }
+                mWasConnected = isConnected;
 
                 // Exit if failure since too long
+                if (!isConnected)
                 {
-                    bool isDisconnected = !mLastConnectionSuccess;
-                    if (isDisconnected)
+                    double disconnectionTime = HelloImGui::Internal::ClockSeconds() - mTimePointConnectionEnded;
+                    bool isTooLong = disconnectionTime > remoteParams().durationMaxDisconnected;
+                    if (isTooLong)
                     {
-                        double disconnectionTime = HelloImGui::Internal::ClockSeconds() - mTimePointConnectionEnded;
-                        std::string msg = "Disconnected since " + std::to_string(disconnectionTime) + "s";
-                        LogStatus(msg);
-                        bool isTooLong = disconnectionTime > remoteParams().durationMaxDisconnected;
-                        if (isTooLong)
-                        {
-                            LogStatus("Too long disconnected... Exiting\n");
-                            runnerParams().appShallExit = true;
-                        }
+                        LogStatus("Too long disconnected... Exiting\n");
+                        runnerParams().appShallExit = true;
                     }
                 }
             }
@@ -123,34 +126,73 @@ namespace HelloImGui
 
             bool isConnected()
             {
-                return NetImgui::IsConnected();
+                return mState.load() == NetImguiConnectionState::Connected;
             }
 
         private:
-            void InitiateConnection()
+            // Runs in the connection thread
+            void ConnectionThreadLoop()
             {
-                NetimguiLog("NetImGuiWrapper: InitiateConnection\n");
-                mNetImguiRaii.release();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                mNetImguiRaii = std::make_unique<NetImGuiRaii>();
-                NetImgui::ConnectToApp(clientName().c_str(), remoteParams().serverHost.c_str(), remoteParams().serverPort);
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                ++ mNbConnectionsTentatives;
-                _sendFonts_Impl();
+                double reconnectDelay = mReconnectDelayMin;
+                while (!IsStopRequested())
+                {
+                    mState = NetImguiConnectionState::Connecting;
+                    ++ mNbConnectionsTentatives;
+                    NetimguiLog("NetImGuiWrapper: connecting to %s:%u (tentative %i)\n", mServerHost.c_str(), mServerPort, mNbConnectionsTentatives.load());
+                    // ConnectToApp is asynchronous: NetImgui connects in its own thread
+                    std::string clientName = mClientName + "##" + std::to_string(HelloImGui::Internal::ClockSeconds());
+                    NetImgui::ConnectToApp(clientName.c_str(), mServerHost.c_str(), mServerPort);
+                    WaitOrStop(0.1);
+                    while (NetImgui::IsConnectionPending() && !WaitOrStop(0.05))
+                        ;
+                    if (IsStopRequested())
+                        break;
+
+                    if (NetImgui::IsConnected())
+                    {
+                        ++ mNbConnectionsSuccess;
+                        reconnectDelay = mReconnectDelayMin;
+                        mState = NetImguiConnectionState::Connected;
+                        // The app may be producing frames slowly while no viewer is connected
+                        HelloImGui::RequestRedraw();
+                        while (NetImgui::IsConnected() && !WaitOrStop(0.1))
+                            ;
+                        HelloImGui::RequestRedraw();
+                        if (IsStopRequested() || mStopAfterDisconnection)
+                            break;
+                    }
+                    else
+                        ++ mNbConnectionsFailures;
+
+                    // Exponential backoff between tentatives
+                    mState = NetImguiConnectionState::WaitingBeforeRetry;
+                    NetimguiLog("NetImGuiWrapper: not connected, next tentative in %.1fs\n", reconnectDelay);
+                    WaitOrStop(reconnectDelay);
+                    reconnectDelay = ImMin(reconnectDelay * 2.0, mReconnectDelayMax);
+                }
+                if (NetImgui::IsConnected() || NetImgui::IsConnectionPending())
+                    NetImgui::Disconnect();
+                mState = NetImguiConnectionState::Stopped;
+            }
+
+            // Waits for the given duration, and returns true if a stop was requested
+            bool WaitOrStop(double durationSeconds)
+            {
+                std::unique_lock<std::mutex> lock(mStopMutex);
+                mStopCondition.wait_for(lock, std::chrono::duration<double>(durationSeconds), [this] { return mStopRequested; });
+                return mStopRequested;
             }
 
-            std::string clientName()
+            bool IsStopRequested()
             {
-                std::string clientName = runnerParams().appWindowParams.windowTitle;
-                if (clientName.empty())
-                    clientName = "HelloImGui";
-                clientName += "##" + std::to_string(ImGui::GetTime());
-                return clientName;
+                std::lock_guard<std::mutex> lock(mStopMutex);
+                return mStopRequested;
             }
 
             HelloImGui::RemoteParams& remoteParams() { return HelloImGui::GetRunnerParams()->remoteParams; }
             HelloImGui::RunnerParams& runnerParams() { return *HelloImGui::GetRunnerParams(); }
 
+            // NetImgui keeps the textures it was sent, and sends them again upon each (re)connection
             void _sendFonts_Impl()
             {
                 const ImFontAtlas* pFonts = ImGui::GetIO().Fonts;
@@ -175,10 +217,27 @@ namespace HelloImGui
 
         private:  // Members
             std::unique_ptr<NetImGuiRaii> mNetImguiRaii;
-            int mNbConnectionsTentatives = 0;
-            int mNbConnectionsSuccess = 0;
-            int mNbConnectionsFailures = 0;
-            bool mLastConnectionSuccess = false;
+
+            // Used by the connection thread
+            std::string mClientName;
+            std::string mServerHost;
+            uint32_t mServerPort = 0;
+            double mReconnectDelayMin = 0.;
+            double mReconnectDelayMax = 0.;
+            bool mStopAfterDisconnection = false;
+            std::thread mConnectionThread;
+            std::mutex mStopMutex;
+            std::condition_variable mStopCondition;
+            bool mStopRequested = false;
+
+            // Shared between the threads
+            std::atomic<NetImguiConnectionState> mState { NetImguiConnectionState::Connecting };
+            std::atomic<int> mNbConnectionsTentatives { 0 };
+            std::atomic<int> mNbConnectionsSuccess { 0 };
+            std::atomic<int> mNbConnectionsFailures { 0 };
+
+            // Used by the main thread
+            bool mWasConnected = false;
             double mTimePointConnectionEnded = 0.0;
         };
 
@@ -290,7 +349,7 @@ namespace HelloImGui
             canvas_id = "my_canvas";
             canvas_width = _WS_CANVAS_WIDTH_;
             canvas_height = _WS_CANVAS_HEIGHT_;
-            update_freq_ms = 16;
+            update_freq_ms = _WS_UPDATE_FREQ_MS_;
             window.addEventListener('load', () => init(canvas_id, canvas_width, canvas_height, update_freq_ms));
 
         </script>
@@ -427,13 +486,12 @@ namespace HelloImGui
 
             // client control management
             struct ClientData {
-                bool hasControl = false;
+                bool hasControl = false;  // only the client which has the control sends inputs to the app
 
                 std::string ip = "---";
             };
 
             // client control
-            float tControl_s = 10.0f;
             float tControlNext_s = 0.0f;
 
             int controlIteration = 0;
@@ -553,20 +611,56 @@ namespace HelloImGui
                 }
             }
 
-            void update()
+            void setControl(int clientId)
+            {
+                if (clients.find(curIdControl) != clients.end()) {
+                    clients[curIdControl].hasControl = false;
+                }
+                curIdControl = clientId;
+                if (clients.find(curIdControl) != clients.end()) {
+                    clients[curIdControl].hasControl = true;
+                }
+                ImGui::GetIO().ClearInputKeys();
+            }
+
+            // The control goes from one client to the next every wsControlDurationSeconds
+            void updateControl_RoundRobin()
             {
                 if (clients.size() > 0 && (clients.find(curIdControl) == clients.end() || ImGui::GetTime() > tControlNext_s)) {
-                    if (clients.find(curIdControl) != clients.end()) {
-                        clients[curIdControl].hasControl = false;
-                    }
                     int k = ++controlIteration % clients.size();
                     auto client = clients.begin();
                     std::advance(client, k);
-                    client->second.hasControl = true;
-                    curIdControl = client->first;
-                    tControlNext_s = ImGui::GetTime() + tControl_s;
-                    ImGui::GetIO().ClearInputKeys();
+                    setControl(client->first);
+                    tControlNext_s = ImGui::GetTime() + HelloImGui::GetRunnerParams()->remoteParams.wsControlDurationSeconds;
+                }
+            }
+
+            // The operator keeps the control until it disconnects
+            void updateControl_Operator()
+            {
+                if (clients.find(curIdControl) != clients.end())
+                    return;
+                const auto& operatorIps = HelloImGui::GetRunnerParams()->remoteParams.wsOperatorIps;
+                // clients are sorted by id, i.e. by connection order
+                for (const auto& client : clients) {
+                    bool canOperate = operatorIps.empty()
+                        || std::find(operatorIps.begin(), operatorIps.end(), client.second.ip) != operatorIps.end();
+                    if (canOperate) {
+                        setControl(client.first);
+                        return;
+                    }
                 }
+                // No client may operate: all of them are viewers
+                if (curIdControl != -1)
+                    setControl(-1);
+            }
+
+            void update()
+            {
+                if (HelloImGui::GetRunnerParams()->remoteParams.wsControlMode == WsControlMode::Operator)
+                    updateControl_Operator();
+                else
+                    updateControl_RoundRobin();
 
                 if (clients.size() == 0) {
                     curIdControl = -1;
@@ -613,18 +707,22 @@ namespace HelloImGui
 
         ImGuiWS gImguiWS;
         ImguiWsInputs gImguiWsInputs;
+        DrawListsDeltaTracker gDrawListsDeltaTracker;
 
         void Create()
         {
             auto& remoteParams = HelloImGui::GetRunnerParams()->remoteParams;
             int32_t port = (int32_t)HelloImGui::GetRunnerParams()->remoteParams.wsPort;
             gImguiWS.init(port, remoteParams.wsHttpRootFolder, {"", "index.html"});
+            // The first frame of this session shall be transmitted (the runner may have been restarted)
+            gDrawListsDeltaTracker = DrawListsDeltaTracker();
             if (remoteParams.wsProvideIndexHtml)
             {
                 std::string indexHtml = gIndexHtmlSource;
                 indexHtml = ReplaceInString(indexHtml, "_WS_TITLE_", HelloImGui::GetRunnerParams()->appWindowParams.windowTitle);
                 indexHtml = ReplaceInString(indexHtml, "_WS_CANVAS_WIDTH_", std::to_string(HelloImGui::GetRunnerParams()->appWindowParams.windowGeometry.size[0]));
                 indexHtml = ReplaceInString(indexHtml, "_WS_CANVAS_HEIGHT_", std::to_string(HelloImGui::GetRunnerParams()->appWindowParams.windowGeometry.size[1]));
+                indexHtml = ReplaceInString(indexHtml, "_WS_UPDATE_FREQ_MS_", std::to_string(ImClamp(remoteParams.wsUpdateFreqMs, 16, 200)));
                 gImguiWS.addResource("/index.html", indexHtml);
             }
         }
@@ -668,6 +766,16 @@ namespace HelloImGui
             auto& io = ImGui::GetIO();
             io.DisplaySize = appSizeImVec2;
 
+            // When a viewer connects or disconnects, the frame rate changes (see ComputeRemoteProduceFps):
+            // do not wait for the rest of the current period
+            static int32_t lastNbConnected = 0;
+            int32_t nbConnected = gImguiWS.nConnected();
+            if (nbConnected != lastNbConnected)
+            {
+                lastNbConnected = nbConnected;
+                HelloImGui::RequestRedraw();
+            }
+
             // websocket event handling
             auto events = gImguiWS.takeEvents();
             for (auto & event : events) {
@@ -678,8 +786,17 @@ namespace HelloImGui
 
         void Heartbeat_PostImGuiRender()
         {
+            ImDrawData* drawData = ImGui::GetDrawData();
+            if (HelloImGui::GetRunnerParams()->remoteParams.wsSkipUnchangedDrawData)
+            {
+                // imgui-ws serializes and sends the whole draw data to the clients:
+                // skip it when no draw list changed since the previous frame
+                DrawListsDelta delta = gDrawListsDeltaTracker.Update(drawData);
+                if (!delta.HasChanges())
+                    return;
+            }
             // store ImDrawData for asynchronous dispatching to WS clients
-            gImguiWS.setDrawData(ImGui::GetDrawData());
+            gImguiWS.setDrawData(drawData);
         }
 
 
@@ -694,7 +811,7 @@ bool RemoteDisplayHandler::IsConnectedToRemoteDisplay()
     if (!ShouldRemoteDisplay())
         return false;
     #ifdef HELLOIMGUI_WITH_NETIMGUI
-        return NetimguiUtils::gNetImGuiWrapper->isConnected();
+        return NetimguiUtils::gNetImGuiWrapper != nullptr && NetimguiUtils::gNetImGuiWrapper->isConnected();
     #endif
     #ifdef HELLOIMGUI_WITH_IMGUIWS
         auto nConnected = ImguiWsUtils::gImguiWS.nConnected();
@@ -705,6 +822,40 @@ bool RemoteDisplayHandler::IsConnectedToRemoteDisplay()
     return false;
 }
 
+float ComputeRemoteProduceFps(const RemoteViewerStats& viewerStats, const RemoteParams& remoteParams)
+{
+    if (viewerStats.nbViewers <= 0)
+        return ImMax(remoteParams.fpsNoViewer, kMinFpsNoViewer);
+    float fps = remoteParams.fpsRemoteMax;
+    if (viewerStats.configuredPollFps > 0.f)
+        fps = ImMin(fps, viewerStats.configuredPollFps);
+    return ImClamp(fps, ImMin(remoteParams.fpsRemoteMin, remoteParams.fpsRemoteMax), remoteParams.fpsRemoteMax);
+}
+
+RemoteViewerStats RemoteDisplayHandler::GetViewerStats()
+{
+    RemoteViewerStats r;
+    if (!ShouldRemoteDisplay())
+        return r;
+    #ifdef HELLOIMGUI_WITH_NETIMGUI
+        // The NetImgui client API does not expose the server refresh rate
+        r.nbViewers = IsConnectedToRemoteDisplay() ? 1 : 0;
+    #endif
+    #ifdef HELLOIMGUI_WITH_IMGUIWS
+        // The provided index.html polls the draw data every wsUpdateFreqMs.
+        // (imgui-ws does not report when the clients fetch the draw data, so that the actual rate cannot be measured)
+        r.nbViewers = ImguiWsUtils::gImguiWS.nConnected();
+        if (HelloImGui::GetRunnerParams()->remoteParams.wsProvideIndexHtml)
+            r.configuredPollFps = 1000.f / (float)ImClamp(HelloImGui::GetRunnerParams()->remoteParams.wsUpdateFreqMs, 16, 200);
+    #endif
+    return r;
+}
+
+float RemoteDisplayHandler::ProduceFps()
+{
+    return ComputeRemoteProduceFps(GetViewerStats(), HelloImGui::GetRunnerParams()->remoteParams);
+}
+
 bool RemoteDisplayHandler::ShouldRemoteDisplay()
 {
     #if defined(HELLOIMGUI_WITH_NETIMGUI) || defined(HELLOIMGUI_WITH_IMGUIWS)
@@ -721,7 +872,8 @@ void RemoteDisplayHandler::Create()
         return;
     IM_ASSERT(!IsConnectedToRemoteDisplay() && "RemoteDisplayHandler::Create: Already connected to server");
     #ifdef HELLOIMGUI_WITH_NETIMGUI
-    NetimguiUtils::gNetImGuiWrapper = std::make_unique<NetimguiUtils::NetImGuiWrapper>();
+    if (NetimguiUtils::gNetImGuiWrapper == nullptr)
+        NetimguiUtils::gNetImGuiWrapper = std::make_unique<NetimguiUtils::NetImGuiWrapper>();
     #endif
     #ifdef HELLOIMGUI_WITH_IMGUIWS
     ImguiWsUtils::Create();
@@ -730,9 +882,10 @@ void RemoteDisplayHandler::Create()
 
 void RemoteDisplayHandler::Shutdown()
 {
-    if (!IsConnectedToRemoteDisplay())
+    if (!ShouldRemoteDisplay())
         return;
     #ifdef HELLOIMGUI_WITH_NETIMGUI
+    // Stops the connection thread, even if not connected
     NetimguiUtils::gNetImGuiWrapper.reset();
     #endif
 }
@@ -783,7 +936,8 @@ void RemoteDisplayHandler::SendFonts()
     if (ShouldRemoteDisplay())
     {
         #ifdef HELLOIMGUI_WITH_NETIMGUI
-        NetimguiUtils::gNetImGuiWrapper = std::make_unique<NetimguiUtils::NetImGuiWrapper>();
+        if (NetimguiUtils::gNetImGuiWrapper == nullptr)
+            NetimguiUtils::gNetImGuiWrapper = std::make_unique<NetimguiUtils::NetImGuiWrapper>();
         NetimguiUtils::gNetImGuiWrapper->sendFonts();
         #endif
         #ifdef HELLOIMGUI_WITH_IMGUIWS
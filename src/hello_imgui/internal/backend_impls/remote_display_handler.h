@@ -1,8 +1,25 @@
 #pragma once
 #include "hello_imgui/screen_bounds.h"
+#include "hello_imgui/remote_params.h"
 
 namespace HelloImGui
 {
+    // What the remote display knows about its viewers
+    struct RemoteViewerStats
+    {
+        int nbViewers = 0;
+        // Rate at which the viewers are configured to poll the frames (0 if unknown).
+        // This is a configuration value (e.g. RemoteParams.wsUpdateFreqMs), not a measure: a slow link is not detected.
+        float configuredPollFps = 0.f;
+    };
+
+    // The frame rate at which the app should produce frames for its remote viewers:
+    //     - fpsNoViewer when no viewer is connected (at least kMinFpsNoViewer)
+    //     - otherwise, the viewers configured poll rate (or fpsRemoteMax if unknown), within [fpsRemoteMin, fpsRemoteMax]
+    // (kMinFpsNoViewer: frames are needed to detect new viewers)
+    constexpr float kMinFpsNoViewer = 0.5f;
+    float ComputeRemoteProduceFps(const RemoteViewerStats& viewerStats, const RemoteParams& remoteParams);
+
     class RemoteDisplayHandler
     {
     public:
@@ -34,6 +51,12 @@ namespace HelloImGui
         // Can the user quit the application?
         bool CanQuitApp();
 
+        // Number of viewers, and their configured poll rate when it is known
+        RemoteViewerStats GetViewerStats();
+
+        // The frame rate at which the app should produce frames (see ComputeRemoteProduceFps)
+        float ProduceFps();
+
     private:
         // Returns true if the application is connected to a remote server
         // (return false if no remote display is configured/compiled)
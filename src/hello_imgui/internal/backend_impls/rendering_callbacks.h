@@ -69,6 +69,8 @@ namespace HelloImGui
     //
     //                // Swap buffers in the rendering backend
     //                // ==> call RenderingCallbacks.Impl_SwapBuffers()
+    //                //     (or RenderingCallbacks.Impl_AbandonFrame_3D(), if the frame was not rendered:
+    //                //      see RendererBackendOptions.skipUnchangedFrames)
     //        }
     //
     //        // Shutdown ImGui
@@ -95,6 +97,9 @@ namespace HelloImGui
         VoidFunction                  Impl_NewFrame_3D          = [] { HIMG_ERROR("Empty function"); };
         std::function<void(ImVec4)>   Impl_Frame_3D_ClearColor  = [] (ImVec4) { HIMG_ERROR("Empty function"); };
         VoidFunction                  Impl_RenderDrawData_To_3D = [] { HIMG_ERROR("Empty function"); };
+        // Releases what Impl_NewFrame_3D acquired, when the frame is neither rendered nor swapped
+        // (only needed by backends which acquire the frame buffer in Impl_NewFrame_3D, e.g. Metal)
+        VoidFunction                  Impl_AbandonFrame_3D      = [] {};
         VoidFunction                  Impl_Shutdown_3D          = [] { HIMG_ERROR("Empty function"); };
         std::function<ImageBuffer()>  Impl_ScreenshotRgb_3D     = [] { return ImageBuffer{}; };
         std::function<ScreenSize()>   Impl_GetFrameBufferSize;   //= [] { return ScreenSize{0, 0}; };
@@ -89,6 +89,14 @@ namespace HelloImGui
             ImGui_ImplMetal_RenderDrawData(ImGui::GetDrawData(), gMetalGlobals.mtlCommandBuffer, gMetalGlobals.mtlRenderCommandEncoder);
         };
 
+        // The drawable acquired by Impl_NewFrame_3D shall be released, even if it is not presented
+        callbacks->Impl_AbandonFrame_3D = []
+        {
+            auto& gMetalGlobals = GetMetalGlobals();
+            [gMetalGlobals.caMetalDrawable release];
+            gMetalGlobals.caMetalDrawable = nullptr;
+        };
+
         // Not implemented for Metal
         //callbacks.Impl_ScreenshotRgb = []() { ...;};
 
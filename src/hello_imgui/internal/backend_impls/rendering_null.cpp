@@ -1,23 +1,39 @@
 #include "rendering_null.h"
+#include "software_rasterizer.h"
 
 
 namespace HelloImGui
 {
+    // When the software rasterizer was not initialized (see PrepareNullRendering), all these callbacks do nothing
     RenderingCallbacksPtr CreateBackendCallbacks_Null()
     {
         auto callbacks = std::make_shared<RenderingCallbacks>();
 
         callbacks->Impl_NewFrame_3D = [] {};
 
-        callbacks->Impl_RenderDrawData_To_3D = [] {};
+        callbacks->Impl_RenderDrawData_To_3D = [] {
+            SoftwareRasterizer::RenderDrawData(ImGui::GetDrawData());
+        };
 
-        callbacks->Impl_ScreenshotRgb_3D = []() { return ImageBuffer{}; };
+        callbacks->Impl_ScreenshotRgb_3D = []() {
+            return SoftwareRasterizer::ScreenshotRgb();
+        };
 
-        callbacks->Impl_Frame_3D_ClearColor = [](ImVec4) {};
+        callbacks->Impl_Frame_3D_ClearColor = [](ImVec4 clear_color) {
+            SoftwareRasterizer::ClearFramebuffer(clear_color);
+        };
 
-        callbacks->Impl_Shutdown_3D = [] {};
+        callbacks->Impl_Shutdown_3D = [] {
+            SoftwareRasterizer::Shutdown();
+        };
 
         return callbacks;
     }
 
+    void PrepareNullRendering(bool useSoftwareRasterizer)
+    {
+        if (useSoftwareRasterizer)
+            SoftwareRasterizer::Init();
+    }
+
 }
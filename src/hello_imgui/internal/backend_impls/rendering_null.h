@@ -5,4 +5,8 @@
 namespace HelloImGui
 {
     RenderingCallbacksPtr CreateBackendCallbacks_Null();
+
+    // Starts the software rasterizer (see RendererBackendOptions.nullBackendSoftwareRasterizer).
+    // Shall be called before the fonts are loaded.
+    void PrepareNullRendering(bool useSoftwareRasterizer);
 }
@@ -2,6 +2,7 @@
 #include "hello_imgui/internal/backend_impls/abstract_runner.h"
 #include "hello_imgui/internal/backend_impls/backend_window_helper/null_window_helper.h"
 #include "hello_imgui/internal/backend_impls/null_config.h"
+#include "hello_imgui/internal/backend_impls/rendering_null.h"
 
 
 namespace HelloImGui
@@ -29,7 +30,11 @@ namespace HelloImGui
         void Impl_Cleanup() override {}
         void Impl_SwapBuffers() override {}
         void Impl_SetWindowIcon() override {}
-        void Impl_LinkPlatformAndRenderBackends() override {}
+        void Impl_LinkPlatformAndRenderBackends() override
+        {
+            if (params.rendererBackendType == RendererBackendType::Null)
+                PrepareNullRendering(params.rendererBackendOptions.nullBackendSoftwareRasterizer && !ShouldRemoteDisplay());
+        }
 
 #ifdef HELLOIMGUI_HAS_OPENGL
        public:
@@ -0,0 +1,672 @@
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+#include "hello_imgui/internal/worker_pool.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+// Under emscripten, threads are only available when built with HELLOIMGUI_EMSCRIPTEN_PTHREAD
+#if defined(__EMSCRIPTEN__) && !defined(HELLOIMGUI_EMSCRIPTEN_PTHREAD)
+#define HELLOIMGUI_SOFTWARE_RASTERIZER_NO_THREAD
+#endif
+
+#ifndef HELLOIMGUI_SOFTWARE_RASTERIZER_NO_THREAD
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HELLOIMGUI_SOFTWARE_RASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace HelloImGui
+{
+    void SoftwareTexture::Store(int width, int height, const unsigned char* image_data_rgba)
+    {
+        Width = width;
+        Height = height;
+        Pixels.resize((size_t)width * (size_t)height);
+        memcpy(Pixels.data(), image_data_rgba, Pixels.size() * sizeof(ImU32));
+    }
+
+
+    namespace SoftwareRasterizer
+    {
+        // ---------------------------------------------------------------------------------------------
+        // Pixel operations (colors are packed as IM_COL32, channels are in 0..255)
+        // ---------------------------------------------------------------------------------------------
+
+        // Exact rounding of t / 255, for t <= 255 * 255
+        static inline ImU32 priv_Div255(ImU32 t)
+        {
+            t += 128;
+            return (t + (t >> 8)) >> 8;
+        }
+
+        static inline ImU32 priv_MulChannel(ImU32 a, ImU32 b) { return priv_Div255(a * b); }
+
+        // Vertex color * texel
+        static inline ImU32 priv_Modulate(ImU32 color, ImU32 texel)
+        {
+            if (color == IM_COL32_WHITE)
+                return texel;
+            if (texel == IM_COL32_WHITE)
+                return color;
+            ImU32 r = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+                r |= priv_MulChannel((color >> shift) & 0xFF, (texel >> shift) & 0xFF) << shift;
+            return r;
+        }
+
+        // dst = src * srcAlpha + dst * (1 - srcAlpha) for RGB, and dstAlpha = srcAlpha + dstAlpha * (1 - srcAlpha)
+        // (i.e. glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA))
+        static inline ImU32 priv_BlendPixel(ImU32 dst, ImU32 src)
+        {
+            ImU32 srcAlpha = src >> 24;
+            if (srcAlpha == 255)
+                return src;
+            if (srcAlpha == 0)
+                return dst;
+            ImU32 invAlpha = 255 - srcAlpha;
+            ImU32 r = priv_Div255((src & 0xFF) * srcAlpha + (dst & 0xFF) * invAlpha);
+            ImU32 g = priv_Div255(((src >> 8) & 0xFF) * srcAlpha + ((dst >> 8) & 0xFF) * invAlpha);
+            ImU32 b = priv_Div255(((src >> 16) & 0xFF) * srcAlpha + ((dst >> 16) & 0xFF) * invAlpha);
+            ImU32 a = priv_Div255(255 * srcAlpha + (dst >> 24) * invAlpha);
+            return r | (g << 8) | (b << 16) | (a << 24);
+        }
+
+#ifdef HELLOIMGUI_SOFTWARE_RASTERIZER_SSE2
+        // The SSE2 blend works on 2 pixels at a time, unpacked to 16 bits per channel:
+        //     result = Div255(src * srcMul + dst * invAlpha)
+        // where srcMul = (srcAlpha, srcAlpha, srcAlpha, 255) and invAlpha = 255 - srcAlpha.
+        // All intermediate values are <= 255 * 255, so that they fit in unsigned 16 bits lanes.
+        static inline __m128i priv_Div255_Sse2(__m128i t)
+        {
+            t = _mm_add_epi16(t, _mm_set1_epi16(128));
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        }
+
+        static inline void priv_BlendFactors_Sse2(__m128i src16, __m128i* outSrcTerm, __m128i* outInvAlpha)
+        {
+            const __m128i c255 = _mm_set1_epi16(255);
+            const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+            __m128i srcAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i srcMul = _mm_or_si128(_mm_andnot_si128(alphaLanes, srcAlpha), _mm_and_si128(alphaLanes, c255));
+            *outSrcTerm = _mm_mullo_epi16(src16, srcMul);
+            *outInvAlpha = _mm_sub_epi16(c255, srcAlpha);
+        }
+
+        static inline __m128i priv_Blend2Pixels_Sse2(__m128i src16, __m128i dst16)
+        {
+            __m128i srcTerm, invAlpha;
+            priv_BlendFactors_Sse2(src16, &srcTerm, &invAlpha);
+            return priv_Div255_Sse2(_mm_add_epi16(srcTerm, _mm_mullo_epi16(dst16, invAlpha)));
+        }
+#endif
+
+        static void priv_BlendSpan(ImU32* dst, const ImU32* src, int nbPixels)
+        {
+            int i = 0;
+#ifdef HELLOIMGUI_SOFTWARE_RASTERIZER_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 4 <= nbPixels; i += 4)
+            {
+                __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+                __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+                __m128i lo = priv_Blend2Pixels_Sse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+                __m128i hi = priv_Blend2Pixels_Sse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+            }
+#endif
+            for (; i < nbPixels; ++i)
+                dst[i] = priv_BlendPixel(dst[i], src[i]);
+        }
+
+        static void priv_BlendSpanConstant(ImU32* dst, ImU32 color, int nbPixels)
+        {
+            ImU32 alpha = color >> 24;
+            if (alpha == 0)
+                return;
+            if (alpha == 255)
+            {
+                std::fill(dst, dst + nbPixels, color);
+                return;
+            }
+            int i = 0;
+#ifdef HELLOIMGUI_SOFTWARE_RASTERIZER_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            __m128i srcTerm, invAlpha;
+            priv_BlendFactors_Sse2(_mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero), &srcTerm, &invAlpha);
+            for (; i + 4 <= nbPixels; i += 4)
+            {
+                __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+                __m128i lo = priv_Div255_Sse2(_mm_add_epi16(srcTerm, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invAlpha)));
+                __m128i hi = priv_Div255_Sse2(_mm_add_epi16(srcTerm, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invAlpha)));
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+            }
+#endif
+            for (; i < nbPixels; ++i)
+                dst[i] = priv_BlendPixel(dst[i], color);
+        }
+
+        static inline ImU32 priv_LerpColor(ImU32 a, ImU32 b, ImU32 weight) // weight in 0..256
+        {
+            // Red & blue, then green & alpha: each channel has 16 bits of headroom
+            ImU32 rb = (((a & 0x00FF00FF) * (256 - weight) + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+            ImU32 ga = (((a >> 8) & 0x00FF00FF) * (256 - weight) + ((b >> 8) & 0x00FF00FF) * weight) & 0xFF00FF00;
+            return rb | ga;
+        }
+
+        // Bilinear sampling, with clamp to edge (like ImGui's OpenGL backend, which uses GL_LINEAR)
+        static ImU32 priv_SampleBilinear(const SoftwareTexture& texture, float u, float v)
+        {
+            float fx = u * (float)texture.Width - 0.5f;
+            float fy = v * (float)texture.Height - 0.5f;
+            fx = ImClamp(fx, -1.f, (float)texture.Width);
+            fy = ImClamp(fy, -1.f, (float)texture.Height);
+            float floorX = floorf(fx), floorY = floorf(fy);
+            ImU32 weightX = (ImU32)((fx - floorX) * 256.f);
+            ImU32 weightY = (ImU32)((fy - floorY) * 256.f);
+            int x0 = ImClamp((int)floorX, 0, texture.Width - 1), x1 = ImClamp((int)floorX + 1, 0, texture.Width - 1);
+            int y0 = ImClamp((int)floorY, 0, texture.Height - 1), y1 = ImClamp((int)floorY + 1, 0, texture.Height - 1);
+
+            const ImU32* row0 = texture.Pixels.data() + (size_t)y0 * texture.Width;
+            const ImU32* row1 = texture.Pixels.data() + (size_t)y1 * texture.Width;
+            ImU32 top = priv_LerpColor(row0[x0], row0[x1], weightX);
+            ImU32 bottom = priv_LerpColor(row1[x0], row1[x1], weightX);
+            return priv_LerpColor(top, bottom, weightY);
+        }
+
+        static inline ImU32 priv_PackColor(const float rgba[4])
+        {
+            ImU32 r = 0;
+            for (int i = 0; i < 4; ++i)
+                r |= (ImU32)(ImClamp(rgba[i], 0.f, 255.f) + 0.5f) << (i * 8);
+            return r;
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // Triangle setup
+        // ---------------------------------------------------------------------------------------------
+        constexpr int kTileSize = 64;
+
+        struct RasterTriangle
+        {
+            // Edge functions: E(x, y) = EdgeA * x + EdgeB * y + EdgeC, >= 0 inside the triangle
+            // (the 4th lane is unused)
+            float EdgeA[4], EdgeB[4], EdgeC[4];
+            // Plane equations of the attributes: value(x, y) = Origin + Dx * x + Dy * y
+            float ColorOrigin[4], ColorDx[4], ColorDy[4]; // RGBA in 0..255
+            float UvOrigin[4], UvDx[4], UvDy[4];          // (u, v, unused, unused)
+            // Bounding box, intersected with the clip rect and the framebuffer (max is exclusive)
+            int MinX, MinY, MaxX, MaxY;
+            const SoftwareTexture* Texture;
+            bool HasConstantColor, HasConstantUv;
+            ImU32 ConstantColor;   // Vertex color, if HasConstantColor
+            ImU32 ConstantTexel;   // Texel, if HasConstantUv
+            ImU32 FlatColor;       // ConstantColor * ConstantTexel, if HasConstantColor && HasConstantUv
+        };
+
+        // Geometry shared by the plane equations of a triangle
+        struct TriangleGeometry
+        {
+            float x0, y0;
+            float e1x, e1y, e2x, e2y; // (p1 - p0), (p2 - p0)
+            float invArea;
+        };
+
+        // Plane equations of 4 attributes (a0, a1, a2 are their values at the 3 vertices)
+        static void priv_ComputePlanes4(
+            const TriangleGeometry& g, const float a0[4], const float a1[4], const float a2[4],
+            float outOrigin[4], float outDx[4], float outDy[4])
+        {
+#ifdef HELLOIMGUI_SOFTWARE_RASTERIZER_SSE2
+            __m128 v0 = _mm_loadu_ps(a0);
+            __m128 d1 = _mm_sub_ps(_mm_loadu_ps(a1), v0);
+            __m128 d2 = _mm_sub_ps(_mm_loadu_ps(a2), v0);
+            __m128 invArea = _mm_set1_ps(g.invArea);
+            __m128 dx = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(d1, _mm_set1_ps(g.e2y)), _mm_mul_ps(d2, _mm_set1_ps(g.e1y))), invArea);
+            __m128 dy = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(d2, _mm_set1_ps(g.e1x)), _mm_mul_ps(d1, _mm_set1_ps(g.e2x))), invArea);
+            __m128 origin = _mm_sub_ps(_mm_sub_ps(v0, _mm_mul_ps(dx, _mm_set1_ps(g.x0))), _mm_mul_ps(dy, _mm_set1_ps(g.y0)));
+            _mm_storeu_ps(outOrigin, origin);
+            _mm_storeu_ps(outDx, dx);
+            _mm_storeu_ps(outDy, dy);
+#else
+            for (int i = 0; i < 4; ++i)
+            {
+                float d1 = a1[i] - a0[i], d2 = a2[i] - a0[i];
+                outDx[i] = (d1 * g.e2y - d2 * g.e1y) * g.invArea;
+                outDy[i] = (d2 * g.e1x - d1 * g.e2x) * g.invArea;
+                outOrigin[i] = a0[i] - outDx[i] * g.x0 - outDy[i] * g.y0;
+            }
+#endif
+        }
+
+        static void priv_ComputeEdges(const float x[3], const float y[3], float sign, RasterTriangle* t)
+        {
+#ifdef HELLOIMGUI_SOFTWARE_RASTERIZER_SSE2
+            __m128 xs = _mm_setr_ps(x[0], x[1], x[2], 0.f), ys = _mm_setr_ps(y[0], y[1], y[2], 0.f);
+            __m128 xsNext = _mm_setr_ps(x[1], x[2], x[0], 0.f), ysNext = _mm_setr_ps(y[1], y[2], y[0], 0.f);
+            __m128 s = _mm_set1_ps(sign);
+            _mm_storeu_ps(t->EdgeA, _mm_mul_ps(_mm_sub_ps(ys, ysNext), s));
+            _mm_storeu_ps(t->EdgeB, _mm_mul_ps(_mm_sub_ps(xsNext, xs), s));
+            _mm_storeu_ps(t->EdgeC, _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(xs, ysNext), _mm_mul_ps(xsNext, ys)), s));
+#else
+            for (int i = 0; i < 3; ++i)
+            {
+                int next = (i + 1) % 3;
+                t->EdgeA[i] = (y[i] - y[next]) * sign;
+                t->EdgeB[i] = (x[next] - x[i]) * sign;
+                t->EdgeC[i] = (x[i] * y[next] - x[next] * y[i]) * sign;
+            }
+#endif
+        }
+
+        static void priv_ColorToFloats(ImU32 color, float out[4])
+        {
+            for (int i = 0; i < 4; ++i)
+                out[i] = (float)((color >> (i * 8)) & 0xFF);
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // Rasterizer state
+        // ---------------------------------------------------------------------------------------------
+        struct RasterizerState
+        {
+            int FramebufferWidth = 0, FramebufferHeight = 0;
+            std::vector<ImU32> Framebuffer;
+            bool HasPendingClear = false;
+            ImU32 PendingClearColor = 0;
+
+            int NbTilesX = 0, NbTilesY = 0;
+            std::vector<RasterTriangle> Triangles;
+            std::vector<std::vector<uint32_t>> TileTriangles; // indices into Triangles, in submission order
+
+            std::unique_ptr<WorkerPool> Pool;
+            int NbWorkers = 0;
+        };
+
+        static std::unique_ptr<RasterizerState> gState;
+
+        static void priv_ResizeFramebuffer(RasterizerState& s, int width, int height)
+        {
+            if (width == s.FramebufferWidth && height == s.FramebufferHeight)
+                return;
+            s.FramebufferWidth = width;
+            s.FramebufferHeight = height;
+            s.Framebuffer.assign((size_t)width * (size_t)height, 0);
+            s.NbTilesX = (width + kTileSize - 1) / kTileSize;
+            s.NbTilesY = (height + kTileSize - 1) / kTileSize;
+            s.TileTriangles.resize((size_t)s.NbTilesX * s.NbTilesY);
+        }
+
+        static void priv_SetupTriangle(
+            RasterizerState& s,
+            const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2,
+            ImVec2 offset, ImVec2 scale, const int clip[4], const SoftwareTexture* texture)
+        {
+            float x[3] = { (v0.pos.x - offset.x) * scale.x, (v1.pos.x - offset.x) * scale.x, (v2.pos.x - offset.x) * scale.x };
+            float y[3] = { (v0.pos.y - offset.y) * scale.y, (v1.pos.y - offset.y) * scale.y, (v2.pos.y - offset.y) * scale.y };
+
+            TriangleGeometry g;
+            g.x0 = x[0]; g.y0 = y[0];
+            g.e1x = x[1] - x[0]; g.e1y = y[1] - y[0];
+            g.e2x = x[2] - x[0]; g.e2y = y[2] - y[0];
+            float area = g.e1x * g.e2y - g.e2x * g.e1y;
+            if (fabsf(area) < 1e-6f)
+                return;
+            g.invArea = 1.f / area;
+
+            RasterTriangle t;
+            t.MinX = ImMax(clip[0], (int)floorf(ImMin(ImMin(x[0], x[1]), x[2])));
+            t.MinY = ImMax(clip[1], (int)floorf(ImMin(ImMin(y[0], y[1]), y[2])));
+            t.MaxX = ImMin(clip[2], (int)ceilf(ImMax(ImMax(x[0], x[1]), x[2])));
+            t.MaxY = ImMin(clip[3], (int)ceilf(ImMax(ImMax(y[0], y[1]), y[2])));
+            if (t.MinX >= t.MaxX || t.MinY >= t.MaxY)
+                return;
+
+            if (texture != nullptr && texture->Pixels.empty())
+                texture = nullptr;
+            t.Texture = texture;
+            t.HasConstantColor = (v0.col == v1.col) && (v1.col == v2.col);
+            t.HasConstantUv = (texture == nullptr)
+                || ((v0.uv.x == v1.uv.x) && (v1.uv.x == v2.uv.x) && (v0.uv.y == v1.uv.y) && (v1.uv.y == v2.uv.y));
+            t.ConstantColor = v0.col;
+            t.ConstantTexel = (texture == nullptr || !t.HasConstantUv) ? IM_COL32_WHITE : priv_SampleBilinear(*texture, v0.uv.x, v0.uv.y);
+            t.FlatColor = priv_Modulate(t.ConstantColor, t.ConstantTexel);
+            if (t.HasConstantColor && t.HasConstantUv && (t.FlatColor >> 24) == 0)
+                return; // invisible
+
+            priv_ComputeEdges(x, y, area > 0.f ? 1.f : -1.f, &t);
+            if (!t.HasConstantColor)
+            {
+                float c0[4], c1[4], c2[4];
+                priv_ColorToFloats(v0.col, c0);
+                priv_ColorToFloats(v1.col, c1);
+                priv_ColorToFloats(v2.col, c2);
+                priv_ComputePlanes4(g, c0, c1, c2, t.ColorOrigin, t.ColorDx, t.ColorDy);
+            }
+            if (!t.HasConstantUv)
+            {
+                float uv0[4] = { v0.uv.x, v0.uv.y, 0.f, 0.f };
+                float uv1[4] = { v1.uv.x, v1.uv.y, 0.f, 0.f };
+                float uv2[4] = { v2.uv.x, v2.uv.y, 0.f, 0.f };
+                priv_ComputePlanes4(g, uv0, uv1, uv2, t.UvOrigin, t.UvDx, t.UvDy);
+            }
+
+            // Bin the triangle into the tiles it overlaps
+            uint32_t triangleIndex = (uint32_t)s.Triangles.size();
+            s.Triangles.push_back(t);
+            for (int tileY = t.MinY / kTileSize; tileY <= (t.MaxY - 1) / kTileSize; ++tileY)
+                for (int tileX = t.MinX / kTileSize; tileX <= (t.MaxX - 1) / kTileSize; ++tileX)
+                    s.TileTriangles[(size_t)tileY * s.NbTilesX + tileX].push_back(triangleIndex);
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // Tile rasterization
+        // ---------------------------------------------------------------------------------------------
+
+        // Returns ceil(v), clamped to [lo, hi]
+        static inline int priv_CeilClamped(float v, int lo, int hi)
+        {
+            if (!(v > (float)lo)) // also handles NaN
+                return lo;
+            if (v >= (float)hi)
+                return hi;
+            return (int)ceilf(v);
+        }
+
+        static void priv_RasterizeTriangleInTile(
+            RasterizerState& s, const RasterTriangle& t, int tileX0, int tileY0, int tileX1, int tileY1)
+        {
+            int rowStart = ImMax(t.MinY, tileY0), rowEnd = ImMin(t.MaxY, tileY1);
+            int spanMin = ImMax(t.MinX, tileX0), spanMax = ImMin(t.MaxX, tileX1);
+            ImU32 spanPixels[kTileSize];
+
+            for (int y = rowStart; y < rowEnd; ++y)
+            {
+                // Find the pixels whose center is inside the triangle:
+                // left edges include their pixels centers, right edges exclude them (so that shared edges are drawn once)
+                float centerY = (float)y + 0.5f;
+                int xStart = spanMin, xEnd = spanMax;
+                bool isRowEmpty = false;
+                for (int i = 0; i < 3; ++i)
+                {
+                    float a = t.EdgeA[i];
+                    float rowValue = t.EdgeB[i] * centerY + t.EdgeC[i];
+                    if (a > 0.f)
+                        xStart = ImMax(xStart, priv_CeilClamped(-rowValue / a - 0.5f, spanMin, spanMax));
+                    else if (a < 0.f)
+                        xEnd = ImMin(xEnd, priv_CeilClamped(-rowValue / a - 0.5f, spanMin, spanMax));
+                    else if (rowValue < 0.f || (rowValue == 0.f && t.EdgeB[i] < 0.f))
+                        isRowEmpty = true;
+                }
+                if (isRowEmpty || xStart >= xEnd)
+                    continue;
+
+                int nbPixels = xEnd - xStart;
+                ImU32* dst = s.Framebuffer.data() + (size_t)y * s.FramebufferWidth + xStart;
+                if (t.HasConstantColor && t.HasConstantUv)
+                {
+                    priv_BlendSpanConstant(dst, t.FlatColor, nbPixels);
+                    continue;
+                }
+
+                float centerX = (float)xStart + 0.5f;
+                float color[4], uv[2];
+                for (int i = 0; i < 4; ++i)
+                    color[i] = t.ColorOrigin[i] + t.ColorDx[i] * centerX + t.ColorDy[i] * centerY;
+                for (int i = 0; i < 2; ++i)
+                    uv[i] = t.UvOrigin[i] + t.UvDx[i] * centerX + t.UvDy[i] * centerY;
+                for (int k = 0; k < nbPixels; ++k)
+                {
+                    ImU32 vertexColor = t.ConstantColor, texel = t.ConstantTexel;
+                    if (!t.HasConstantColor)
+                    {
+                        vertexColor = priv_PackColor(color);
+                        for (int i = 0; i < 4; ++i)
+                            color[i] += t.ColorDx[i];
+                    }
+                    if (!t.HasConstantUv)
+                    {
+                        texel = priv_SampleBilinear(*t.Texture, uv[0], uv[1]);
+                        uv[0] += t.UvDx[0];
+                        uv[1] += t.UvDx[1];
+                    }
+                    spanPixels[k] = priv_Modulate(vertexColor, texel);
+                }
+                priv_BlendSpan(dst, spanPixels, nbPixels);
+            }
+        }
+
+        static void priv_RasterizeTile(RasterizerState& s, int tileIndex)
+        {
+            int tileX0 = (tileIndex % s.NbTilesX) * kTileSize;
+            int tileY0 = (tileIndex / s.NbTilesX) * kTileSize;
+            int tileX1 = ImMin(tileX0 + kTileSize, s.FramebufferWidth);
+            int tileY1 = ImMin(tileY0 + kTileSize, s.FramebufferHeight);
+
+            if (s.HasPendingClear)
+                for (int y = tileY0; y < tileY1; ++y)
+                {
+                    ImU32* row = s.Framebuffer.data() + (size_t)y * s.FramebufferWidth;
+                    std::fill(row + tileX0, row + tileX1, s.PendingClearColor);
+                }
+
+            for (uint32_t triangleIndex : s.TileTriangles[tileIndex])
+                priv_RasterizeTriangleInTile(s, s.Triangles[triangleIndex], tileX0, tileY0, tileX1, tileY1);
+        }
+
+        // Tiles are handed out to the workers (and to the calling thread) until none is left
+        static void priv_RasterizeAllTiles(RasterizerState& s)
+        {
+            int nbTiles = s.NbTilesX * s.NbTilesY;
+            std::atomic<int> nextTile(0);
+            auto fnRasterizeTiles = [&s, &nextTile, nbTiles]()
+            {
+                for (int tile = nextTile.fetch_add(1); tile < nbTiles; tile = nextTile.fetch_add(1))
+                    priv_RasterizeTile(s, tile);
+            };
+
+#ifndef HELLOIMGUI_SOFTWARE_RASTERIZER_NO_THREAD
+            int nbJobs = ImMin(s.NbWorkers, nbTiles - 1);
+            std::mutex mutex;
+            std::condition_variable condition;
+            int nbJobsDone = 0;
+            for (int i = 0; i < nbJobs; ++i)
+                s.Pool->Submit([&]()
+                {
+                    fnRasterizeTiles();
+                    // notify while holding the lock, since condition is destroyed as soon as the wait is over
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++nbJobsDone;
+                    condition.notify_one();
+                });
+            fnRasterizeTiles();
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&] { return nbJobsDone == nbJobs; });
+#else
+            fnRasterizeTiles();
+#endif
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // ImGui textures (ImGuiBackendFlags_RendererHasTextures)
+        // ---------------------------------------------------------------------------------------------
+        static void priv_CopyTextureRect(ImTextureData* tex, SoftwareTexture* texture, int x, int y, int w, int h)
+        {
+            for (int row = y; row < y + h; ++row)
+            {
+                ImU32* dst = texture->Pixels.data() + (size_t)row * texture->Width + x;
+                const unsigned char* src = (const unsigned char*)tex->GetPixelsAt(x, row);
+                if (tex->Format == ImTextureFormat_RGBA32)
+                    memcpy(dst, src, (size_t)w * sizeof(ImU32));
+                else // ImTextureFormat_Alpha8
+                    for (int i = 0; i < w; ++i)
+                        dst[i] = IM_COL32(255, 255, 255, src[i]);
+            }
+        }
+
+        static void priv_DestroyTexture(ImTextureData* tex)
+        {
+            delete (SoftwareTexture*)(intptr_t)tex->TexID;
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+
+        static void priv_UpdateTexture(ImTextureData* tex)
+        {
+            if (tex->Status == ImTextureStatus_WantCreate)
+            {
+                auto* texture = new SoftwareTexture();
+                texture->Width = tex->Width;
+                texture->Height = tex->Height;
+                texture->Pixels.resize((size_t)tex->Width * (size_t)tex->Height);
+                priv_CopyTextureRect(tex, texture, 0, 0, tex->Width, tex->Height);
+                tex->SetTexID(texture->TextureID());
+                tex->SetStatus(ImTextureStatus_OK);
+            }
+            else if (tex->Status == ImTextureStatus_WantUpdates)
+            {
+                auto* texture = (SoftwareTexture*)(intptr_t)tex->TexID;
+                for (const ImTextureRect& r : tex->Updates)
+                    priv_CopyTextureRect(tex, texture, r.x, r.y, r.w, r.h);
+                tex->SetStatus(ImTextureStatus_OK);
+            }
+            else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+                priv_DestroyTexture(tex);
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // API
+        // ---------------------------------------------------------------------------------------------
+        void Init()
+        {
+            IM_ASSERT(!gState && "SoftwareRasterizer::Init: already initialized");
+            gState = std::make_unique<RasterizerState>();
+#ifndef HELLOIMGUI_SOFTWARE_RASTERIZER_NO_THREAD
+            // The calling thread also rasterizes tiles. Headless runs often share their machine
+            // (e.g. parallel CI jobs): a few workers are enough for a GUI sized framebuffer
+            gState->NbWorkers = ImClamp((int)std::thread::hardware_concurrency() - 1, 0, 4);
+            if (gState->NbWorkers > 0)
+                gState->Pool = std::make_unique<WorkerPool>(gState->NbWorkers);
+#endif
+
+            ImGuiIO& io = ImGui::GetIO();
+            io.BackendRendererName = "hello_imgui_software_rasterizer";
+            io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+            io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+        }
+
+        void Shutdown()
+        {
+            if (!gState)
+                return;
+            for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+                if (tex->RefCount == 1 && tex->TexID != ImTextureID_Invalid)
+                    priv_DestroyTexture(tex);
+
+            ImGuiIO& io = ImGui::GetIO();
+            io.BackendRendererName = nullptr;
+            io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+            gState.reset();
+        }
+
+        bool IsInitialized() { return gState != nullptr; }
+
+        void ClearFramebuffer(ImVec4 clearColor)
+        {
+            if (!gState)
+                return;
+            gState->HasPendingClear = true;
+            gState->PendingClearColor = ImGui::ColorConvertFloat4ToU32(clearColor);
+        }
+
+        void RenderDrawData(ImDrawData* drawData)
+        {
+            if (!gState || drawData == nullptr || !drawData->Valid)
+                return;
+            RasterizerState& s = *gState;
+
+            if (drawData->Textures != nullptr)
+                for (ImTextureData* tex : *drawData->Textures)
+                    if (tex->Status != ImTextureStatus_OK)
+                        priv_UpdateTexture(tex);
+
+            int width = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+            int height = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+            if (width <= 0 || height <= 0)
+                return;
+            priv_ResizeFramebuffer(s, width, height);
+
+            // Setup & bin all triangles
+            s.Triangles.clear();
+            for (auto& tileTriangles : s.TileTriangles)
+                tileTriangles.clear();
+            ImVec2 clipOffset = drawData->DisplayPos;
+            ImVec2 clipScale = drawData->FramebufferScale;
+            for (const ImDrawList* drawList : drawData->CmdLists)
+            {
+                for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+                {
+                    if (cmd.UserCallback != nullptr)
+                    {
+                        if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                            cmd.UserCallback(drawList, &cmd);
+                        continue;
+                    }
+
+                    int clip[4] = {
+                        ImMax((int)((cmd.ClipRect.x - clipOffset.x) * clipScale.x), 0),
+                        ImMax((int)((cmd.ClipRect.y - clipOffset.y) * clipScale.y), 0),
+                        ImMin((int)((cmd.ClipRect.z - clipOffset.x) * clipScale.x), width),
+                        ImMin((int)((cmd.ClipRect.w - clipOffset.y) * clipScale.y), height)
+                    };
+                    if (clip[0] >= clip[2] || clip[1] >= clip[3])
+                        continue;
+
+                    const SoftwareTexture* texture = (const SoftwareTexture*)(intptr_t)cmd.GetTexID();
+                    const ImDrawVert* vertices = drawList->VtxBuffer.Data + cmd.VtxOffset;
+                    const ImDrawIdx* indices = drawList->IdxBuffer.Data + cmd.IdxOffset;
+                    for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+                        priv_SetupTriangle(
+                            s, vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]],
+                            clipOffset, clipScale, clip, texture);
+                }
+            }
+
+            priv_RasterizeAllTiles(s);
+            s.HasPendingClear = false;
+        }
+
+        ImageBuffer ScreenshotRgb()
+        {
+            ImageBuffer r;
+            if (!gState)
+                return r;
+            const RasterizerState& s = *gState;
+            r.width = (std::size_t)s.FramebufferWidth;
+            r.height = (std::size_t)s.FramebufferHeight;
+            r.bufferRgb.resize(r.width * r.height * 3);
+            uint8_t* dst = r.bufferRgb.data();
+            for (ImU32 pixel : s.Framebuffer)
+            {
+                *dst++ = (uint8_t)(pixel & 0xFF);
+                *dst++ = (uint8_t)((pixel >> 8) & 0xFF);
+                *dst++ = (uint8_t)((pixel >> 16) & 0xFF);
+            }
+            return r;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "hello_imgui/hello_imgui_screenshot.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    // A RGBA texture, in CPU memory, which can be sampled by the SoftwareRasterizer.
+    // Its ImTextureID is its address.
+    struct SoftwareTexture
+    {
+        int Width = 0;
+        int Height = 0;
+        std::vector<ImU32> Pixels; // Same layout as IM_COL32 (i.e. R, G, B, A bytes in memory)
+
+        void Store(int width, int height, const unsigned char* image_data_rgba);
+        ImTextureID TextureID() const { return (ImTextureID)(intptr_t)this; }
+    };
+
+
+    // A multithreaded CPU rasterizer for ImDrawData, used by the Null rendering backend
+    // (see RendererBackendOptions.nullBackendSoftwareRasterizer)
+    //
+    // - The framebuffer is split into tiles: triangles are set up and binned into the tiles they overlap,
+    //   then the tiles are rasterized in parallel (each tile draws its triangles in submission order).
+    // - Triangles are rasterized with edge functions, at pixel centers, and blended with
+    //   (SRC_ALPHA, ONE_MINUS_SRC_ALPHA), like ImGui's OpenGL backend.
+    // - Textures are sampled with bilinear filtering. ImGui's textures (font atlas) are handled
+    //   via ImGuiBackendFlags_RendererHasTextures; other textures shall be SoftwareTextures.
+    namespace SoftwareRasterizer
+    {
+        // Registers the rasterizer as ImGui's renderer backend (shall be called before the fonts are loaded)
+        void Init();
+        void Shutdown();
+        bool IsInitialized();
+
+        // The framebuffer is cleared lazily, at the start of the next RenderDrawData()
+        void ClearFramebuffer(ImVec4 clearColor);
+        void RenderDrawData(ImDrawData* drawData);
+
+        ImageBuffer ScreenshotRgb();
+    }
+}
@@ -10,8 +10,9 @@ namespace HelloImGui
         class ClockSeconds_
         {
             // Typical C++ shamanic incantations to get a time in seconds
+            // (steady_clock is monotonic, unlike high_resolution_clock on some platforms)
         private:
-            using Clock = std::chrono::high_resolution_clock;
+            using Clock = std::chrono::steady_clock;
             using second = std::chrono::duration<double, std::ratio<1>>;
             std::chrono::time_point<Clock> mStart;
 
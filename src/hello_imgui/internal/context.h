@@ -2,9 +2,13 @@
 #pragma once
 
 #include "imgui.h"
+#include "hello_imgui/internal/dockable_window_registry.h"
+#include "hello_imgui/internal/draw_commands_cache.h"
+#include "hello_imgui/internal/view_menu_model.h"
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct DockableWindowWaitingForAddition;
@@ -15,6 +19,9 @@ struct HelloImGuiContext
 
     std::vector<DockableWindowWaitingForAddition> DockableWindowsToAdd;
     std::vector<std::string> DockableWindowsToRemove;
+    HelloImGui::DockableWindowRegistry DockableWindowsRegistry;  // Index of RunnerParams.dockingParams.dockableWindows
+    std::unordered_map<const void*, HelloImGui::ViewMenuModel> ViewMenuModels;  // One per dockableWindows vector displayed by the View menu
+    std::unordered_map<ImGuiID, HelloImGui::DockableWindowRenderCache> DockableWindowsRenderCaches;  // By ImGui window id
 
     std::map<std::string, ImGuiID> ImGuiSplitIDs;
 };
@@ -0,0 +1,289 @@
+#include "hello_imgui/internal/dockable_window_registry.h"
+#include "hello_imgui/docking_params.h"
+
+#include <algorithm>
+
+
+namespace HelloImGui
+{
+    std::string DockableWindowIdPart(const std::string& label)
+    {
+        size_t pos = label.find("###");
+        if (pos == std::string::npos)
+            return "";
+        return label.substr(pos);
+    }
+
+    static bool MatchesLabel(const DockableWindow& dockableWindow, const std::string& key)
+    {
+        return dockableWindow.label == key;
+    }
+
+    static bool MatchesId(const DockableWindow& dockableWindow, const std::string& key)
+    {
+        return DockableWindowIdPart(dockableWindow.label) == key;
+    }
+
+    static bool MatchesSplitDockSpace(const DockableWindow& dockableWindow, const std::string& key)
+    {
+        for (const auto& dockingSplit : dockableWindow.dockingParams.dockingSplits)
+            if (dockingSplit.newDock == key)
+                return true;
+        return false;
+    }
+
+    using DockableWindowMatchFunction = bool (*)(const DockableWindow&, const std::string&);
+
+    // FNV-1a
+    static uint64_t HashBytes(uint64_t h, const void* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= (uint64_t)bytes[i];
+            h *= 0x100000001B3ull;
+        }
+        return h;
+    }
+
+    static uint64_t HashString(uint64_t h, const std::string& s)
+    {
+        size_t size = s.size();
+        h = HashBytes(h, &size, sizeof(size));
+        return HashBytes(h, s.data(), s.size());
+    }
+
+    // Hashes what is indexed: the windows addresses and labels, and the dockspaces created by the splits
+    static uint64_t HashDockingParamsRec(uint64_t h, const DockingParams& dockingParams)
+    {
+        size_t nbSplits = dockingParams.dockingSplits.size();
+        h = HashBytes(h, &nbSplits, sizeof(nbSplits));
+        for (const auto& dockingSplit : dockingParams.dockingSplits)
+            h = HashString(h, dockingSplit.newDock);
+
+        size_t nbWindows = dockingParams.dockableWindows.size();
+        h = HashBytes(h, &nbWindows, sizeof(nbWindows));
+        for (const auto& dockableWindow : dockingParams.dockableWindows)
+        {
+            const DockableWindow* ptr = dockableWindow.get();
+            h = HashBytes(h, &ptr, sizeof(ptr));
+            if (ptr == nullptr)
+                continue;
+            h = HashString(h, ptr->label);
+            h = HashDockingParamsRec(h, ptr->dockingParams);
+        }
+        return h;
+    }
+
+    static uint64_t TreeFingerprint(const DockingParams& root)
+    {
+        return HashDockingParamsRec(0xCBF29CE484222325ull, root);
+    }
+
+
+    std::optional<DockableWindowRegistry::Location> DockableWindowRegistry::Resolve(DockingParams& root, Entry& entry)
+    {
+        auto window = entry.window.lock();
+        if (window == nullptr || entry.path.empty())
+            return std::nullopt;
+
+        Location r;
+        std::vector<std::shared_ptr<DockableWindow>>* dockableWindows = &root.dockableWindows;
+        for (size_t level = 0; level < entry.path.size(); ++level)
+        {
+            // path only holds addresses: they are compared, and never dereferenced
+            const DockableWindow* expected = entry.path[level];
+            size_t idx = entry.pathIndices[level];
+            if (idx >= dockableWindows->size() || (*dockableWindows)[idx].get() != expected)
+            {
+                // A previous sibling was removed (or the vector was modified): search by address
+                auto it = std::find_if(dockableWindows->begin(), dockableWindows->end(),
+                                       [expected](const auto& w) { return w.get() == expected; });
+                if (it == dockableWindows->end())
+                    return std::nullopt;
+                idx = (size_t)(it - dockableWindows->begin());
+                entry.pathIndices[level] = (uint32_t)idx;
+            }
+            const auto& found = (*dockableWindows)[idx];
+            r.path.push_back(found.get());
+            r.pathIndices.push_back((uint32_t)idx);
+            if (level + 1 < entry.path.size())
+                dockableWindows = &found->dockingParams.dockableWindows;
+            else
+            {
+                r.window = found;
+                r.siblings = dockableWindows;
+                r.index = idx;
+            }
+        }
+        // window is alive, so that its address cannot have been reused
+        IM_ASSERT(r.window == window);
+        return r;
+    }
+
+    std::optional<DockableWindowRegistry::Location> DockableWindowRegistry::FindInMap(
+        DockingParams& root, EntryMap& entryMap, const std::string& key, DockableWindowMatchFunction matches)
+    {
+        auto it = entryMap.find(key);
+        if (it == entryMap.end())
+            return std::nullopt;
+        auto location = Resolve(root, it->second);
+        if (!location.has_value() || !matches(*location->window, key))
+            return std::nullopt;
+        return location;
+    }
+
+    std::optional<DockableWindowRegistry::Location> DockableWindowRegistry::Find(DockingParams& root, const std::string& labelOrId)
+    {
+        if (mRoot != &root)
+            Rebuild(root);
+        std::string idPart = DockableWindowIdPart(labelOrId);
+        auto fnFind = [&]() -> std::optional<Location>
+        {
+            if (auto r = FindInMap(root, mByLabel, labelOrId, MatchesLabel))
+                return r;
+            if (!idPart.empty())
+                return FindInMap(root, mById, idPart, MatchesId);
+            return std::nullopt;
+        };
+
+        return fnFind();
+    }
+
+    std::optional<DockableWindowRegistry::Location> DockableWindowRegistry::FindSplitOwner(DockingParams& root, const std::string& dockSpaceName)
+    {
+        if (mRoot != &root)
+            Rebuild(root);
+        if (mRootSplitDockSpaces.count(dockSpaceName) > 0)
+        {
+            Location rootLocation;
+            rootLocation.siblings = &root.dockableWindows;
+            return rootLocation;
+        }
+        return FindInMap(root, mBySplitDockSpace, dockSpaceName, MatchesSplitDockSpace);
+    }
+
+    void DockableWindowRegistry::Append(DockingParams& root, const Location* parent, std::shared_ptr<DockableWindow> dockableWindow)
+    {
+        IM_ASSERT(dockableWindow != nullptr);
+        if (mRoot != &root)
+            Rebuild(root);
+        bool isUnderRoot = (parent == nullptr || parent->window == nullptr);
+        auto& dockableWindows = isUnderRoot ? root.dockableWindows : parent->window->dockingParams.dockableWindows;
+        dockableWindows.push_back(dockableWindow);
+
+        Location location;
+        if (!isUnderRoot)
+        {
+            location.path = parent->path;
+            location.pathIndices = parent->pathIndices;
+        }
+        location.window = dockableWindow;
+        location.siblings = &dockableWindows;
+        location.index = dockableWindows.size() - 1;
+        location.path.push_back(dockableWindow.get());
+        location.pathIndices.push_back((uint32_t)location.index);
+        RegisterRec(root, location, true);
+    }
+
+    bool DockableWindowRegistry::Remove(DockingParams& root, const std::string& labelOrId)
+    {
+        auto location = Find(root, labelOrId);
+        if (!location.has_value())
+            return false;
+        auto window = location->window;
+        location->siblings->erase(location->siblings->begin() + (std::ptrdiff_t)location->index);
+
+        // The entries of the window children will fail to resolve, and be replaced when needed
+        auto fnForget = [&window](EntryMap& entryMap, const std::string& key)
+        {
+            auto it = entryMap.find(key);
+            if (it != entryMap.end() && it->second.window.lock() == window)
+                entryMap.erase(it);
+        };
+        fnForget(mByLabel, window->label);
+        std::string idPart = DockableWindowIdPart(window->label);
+        if (!idPart.empty())
+            fnForget(mById, idPart);
+        for (const auto& dockingSplit : window->dockingParams.dockingSplits)
+            fnForget(mBySplitDockSpace, dockingSplit.newDock);
+        return true;
+    }
+
+    void DockableWindowRegistry::Register(DockingParams& root, const Location& location, bool overwrite)
+    {
+        Entry entry;
+        entry.window = location.window;
+        entry.path = location.path;
+        entry.pathIndices = location.pathIndices;
+
+        // The first window (in depth-first order) wins: an existing entry is only replaced if it is stale
+        auto fnRegister = [&](EntryMap& entryMap, const std::string& key, DockableWindowMatchFunction matches)
+        {
+            auto it = entryMap.find(key);
+            if (it == entryMap.end())
+                entryMap.emplace(key, entry);
+            else if (overwrite && !FindInMap(root, entryMap, key, matches).has_value())
+                it->second = entry;
+        };
+        const DockableWindow& dockableWindow = *location.window;
+        fnRegister(mByLabel, dockableWindow.label, MatchesLabel);
+        std::string idPart = DockableWindowIdPart(dockableWindow.label);
+        if (!idPart.empty())
+            fnRegister(mById, idPart, MatchesId);
+        for (const auto& dockingSplit : dockableWindow.dockingParams.dockingSplits)
+            fnRegister(mBySplitDockSpace, dockingSplit.newDock, MatchesSplitDockSpace);
+    }
+
+    void DockableWindowRegistry::RegisterRec(DockingParams& root, const Location& location, bool overwrite)
+    {
+        Register(root, location, overwrite);
+        auto& children = location.window->dockingParams.dockableWindows;
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            if (children[i] == nullptr)
+                continue;
+            Location childLocation;
+            childLocation.window = children[i];
+            childLocation.siblings = &children;
+            childLocation.index = i;
+            childLocation.path = location.path;
+            childLocation.path.push_back(children[i].get());
+            childLocation.pathIndices = location.pathIndices;
+            childLocation.pathIndices.push_back((uint32_t)i);
+            RegisterRec(root, childLocation, overwrite);
+        }
+    }
+
+    void DockableWindowRegistry::Validate(DockingParams& root)
+    {
+        uint64_t fingerprint = TreeFingerprint(root);
+        if (mRoot == &root && fingerprint == mFingerprint)
+            return;
+        Rebuild(root);
+    }
+
+    void DockableWindowRegistry::Rebuild(DockingParams& root)
+    {
+        mByLabel.clear();
+        mById.clear();
+        mBySplitDockSpace.clear();
+        mRootSplitDockSpaces.clear();
+        mRoot = &root;
+        mFingerprint = TreeFingerprint(root);
+        for (const auto& dockingSplit : root.dockingSplits)
+            mRootSplitDockSpaces.insert(dockingSplit.newDock);
+        for (size_t i = 0; i < root.dockableWindows.size(); ++i)
+        {
+            if (root.dockableWindows[i] == nullptr)
+                continue;
+            Location location;
+            location.window = root.dockableWindows[i];
+            location.siblings = &root.dockableWindows;
+            location.index = i;
+            location.path.push_back(location.window.get());
+            location.pathIndices.push_back((uint32_t)i);
+            RegisterRec(root, location, false);
+        }
+    }
+}
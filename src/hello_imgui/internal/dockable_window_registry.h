@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    struct DockableWindow;
+    struct DockingParams;
+
+    // DockableWindowRegistry indexes the dockable windows of a DockingParams tree
+    // (RunnerParams.dockingParams, and the nested DockableWindow.dockingParams), by label,
+    // by ImGui id (the part of the label starting at "###", if any), and by the dockspaces
+    // created by their dockingSplits (and by root.dockingSplits).
+    //
+    // The dockableWindows vectors are public, and may be modified directly by the user:
+    // - each entry stores the path to its window (the ancestors, and their position in each vector),
+    //   which is checked upon lookup in O(depth) pointer comparisons: removed windows are never returned
+    // - Validate() compares a fingerprint of the tree (windows, labels and docking splits), and rebuilds
+    //   the index if it changed. It is called once per frame: windows added or renamed directly
+    //   in the vectors are found after the next call (DockingParams::dockableWindowOfName() falls back
+    //   to a linear search in the meantime).
+    class DockableWindowRegistry
+    {
+    public:
+        // Where a dockable window is in the tree
+        struct Location
+        {
+            std::shared_ptr<DockableWindow> window;
+            std::vector<std::shared_ptr<DockableWindow>>* siblings = nullptr;  // the vector that contains window
+            size_t index = 0;                                                  // window position in siblings
+            std::vector<const DockableWindow*> path;                           // ancestors, then window
+            std::vector<uint32_t> pathIndices;                                 // position of each in its vector
+        };
+
+        // Finds a dockable window by label, or by "###" id
+        std::optional<Location> Find(DockingParams& root, const std::string& labelOrId);
+
+        // Finds the dockable window whose dockingParams.dockingSplits create the given dockspace.
+        // If the dockspace is created by root.dockingSplits, the returned location has a null window.
+        std::optional<Location> FindSplitOwner(DockingParams& root, const std::string& dockSpaceName);
+
+        // Appends a dockable window to root.dockableWindows (if parent or parent->window is null),
+        // or to parent->window->dockingParams.dockableWindows, and registers it
+        void Append(DockingParams& root, const Location* parent, std::shared_ptr<DockableWindow> dockableWindow);
+
+        // Removes a dockable window (found by label or by "###" id) from the tree.
+        // Returns false if not found.
+        bool Remove(DockingParams& root, const std::string& labelOrId);
+
+        // Rebuilds the index if the tree was modified since the last call
+        void Validate(DockingParams& root);
+        void Rebuild(DockingParams& root);
+
+    private:
+        struct Entry
+        {
+            std::weak_ptr<DockableWindow> window;
+            std::vector<const DockableWindow*> path;
+            std::vector<uint32_t> pathIndices;  // hints: positions may shift after a removal
+        };
+        using EntryMap = std::unordered_map<std::string, Entry>;
+        using MatchFunction = bool (*)(const DockableWindow&, const std::string&);
+
+        std::optional<Location> FindInMap(DockingParams& root, EntryMap& entryMap, const std::string& key, MatchFunction matches);
+        std::optional<Location> Resolve(DockingParams& root, Entry& entry);
+        void Register(DockingParams& root, const Location& location, bool overwrite);
+        void RegisterRec(DockingParams& root, const Location& location, bool overwrite);
+
+        EntryMap mByLabel;
+        EntryMap mById;
+        EntryMap mBySplitDockSpace;
+        std::unordered_set<std::string> mRootSplitDockSpaces;
+        const DockingParams* mRoot = nullptr;
+        uint64_t mFingerprint = 0;
+    };
+
+    // The ImGui id part of a label (starting at "###"), or an empty string
+    std::string DockableWindowIdPart(const std::string& label);
+}
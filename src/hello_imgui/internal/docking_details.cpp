@@ -6,6 +6,7 @@
 #include "hello_imgui/hello_imgui.h"
 #include "hello_imgui/internal/functional_utils.h"
 #include "hello_imgui/internal/context.h"
+#include "hello_imgui/internal/gui_cost_profiler.h"
 #include "imgui_internal.h"
 #include "nlohmann/json.hpp"
 
@@ -230,8 +231,11 @@ namespace DockingDetails
         bool shift_mod = ImGui::GetIO().KeyShift;
 
         // Helper to render a single window entry (or submenu), with a unique ImGui ID
-        auto renderOne = [&](std::shared_ptr<DockableWindow> const& win)
+        auto renderOne = [&](std::weak_ptr<DockableWindow> const& weakWin)
         {
+            std::shared_ptr<DockableWindow> win = weakWin.lock();
+            if (win == nullptr)
+                return;
             ImGui::PushID(win.get());
             if (win->customViewMenu)
             {
@@ -260,69 +264,40 @@ namespace DockingDetails
             ImGui::PopID();
         };
 
+        // The sorted and grouped windows are cached, and rebuilt only when the windows change
+        assert(GHelloImGui != nullptr);
+        HelloImGuiContext& h = *GHelloImGui;
+        ViewMenuModel& model = h.ViewMenuModels[&dockableWindows];
+        model.Update(dockableWindows);
+        model.lastUsedFrame = ImGui::GetFrameCount();
+
         if (shift_mod)
         {
             // Flat, alphabetical list when holding Shift
-            auto filtered =
-                dockableWindows | std::views::filter([](auto const& w) { return w->includeInViewMenu; });
-            std::vector<std::shared_ptr<DockableWindow>> sorted(filtered.begin(), filtered.end());
-            std::ranges::sort(sorted, [](auto const& a, auto const& b) { return a->label < b->label; });
-
-            for (auto& win : sorted)
+            for (auto& win : model.windowsByLabel)
                 renderOne(win);
         }
         else
         {
             // Grouped by category
-            auto filtered =
-                dockableWindows | std::views::filter([](auto const& w) { return w->includeInViewMenu; });
-            std::vector<std::shared_ptr<DockableWindow>> windows(filtered.begin(), filtered.end());
-            std::ranges::sort(windows,
-                              [](auto const& a, auto const& b)
-                              {
-                                  if (a->category == b->category)
-                                      return a->label < b->label;
-                                  return a->category < b->category;
-                              });
-
-            std::string currentCategory;
-            std::vector<std::shared_ptr<DockableWindow>> categoryGroup;
-
-            // Unified flush: always clears after rendering
-            auto flushCategoryGroup = [&]()
+            for (const auto& categoryGroup : model.categoryGroups)
             {
-                if (categoryGroup.empty())
-                    return;
-
-                if (!currentCategory.empty())
+                if (!categoryGroup.category.empty())
                 {
-                    if (ImGui::BeginMenu(currentCategory.c_str()))
+                    if (ImGui::BeginMenu(categoryGroup.category.c_str()))
                     {
-                        for (auto& win : categoryGroup)
-                            renderOne(win);
+                        for (size_t i = categoryGroup.begin; i < categoryGroup.end; ++i)
+                            renderOne(model.windowsByCategory[i]);
                         ImGui::EndMenu();
                     }
                 }
                 else
                 {
                     // Top‐level, no category
-                    for (auto& win : categoryGroup)
-                        renderOne(win);
-                }
-
-                categoryGroup.clear();
-            };
-
-            for (auto& win : windows)
-            {
-                if (win->category != currentCategory)
-                {
-                    flushCategoryGroup();
-                    currentCategory = win->category;
+                    for (size_t i = categoryGroup.begin; i < categoryGroup.end; ++i)
+                        renderOne(model.windowsByCategory[i]);
                 }
-                categoryGroup.push_back(win);
             }
-            flushCategoryGroup();
         }
     }
 
@@ -364,6 +339,14 @@ namespace DockingDetails
                 runnerParams.imGuiWindowParams.showStatus_Fps =
                     !runnerParams.imGuiWindowParams.showStatus_Fps;
 
+            if (ImGui::MenuItem(
+                    "Frame profiler in status bar##xxxx", nullptr, runnerParams.imGuiWindowParams.showStatus_FrameProfiler))
+                runnerParams.imGuiWindowParams.showStatus_FrameProfiler =
+                    !runnerParams.imGuiWindowParams.showStatus_FrameProfiler;
+
+            if (ImGui::MenuItem("Top windows (Gui cost)##xxxx", nullptr, GuiCostProfiler::IsPanelVisible()))
+                GuiCostProfiler::SetPanelVisible(!GuiCostProfiler::IsPanelVisible());
+
             if (!ShouldRemoteDisplay())
                 ImGui::MenuItem("Enable Idling", nullptr, &runnerParams.fpsIdling.enableIdling);
             ImGui::EndMenu();
@@ -382,6 +365,13 @@ namespace DockingDetails
             MenuView_Misc(runnerParams);
 
             ImGui::EndMenu();
+
+            // Forget the models of the vectors which were not displayed
+            // (their address may be reused by another vector)
+            assert(GHelloImGui != nullptr);
+            int frameCount = ImGui::GetFrameCount();
+            std::erase_if(GHelloImGui->ViewMenuModels,
+                          [frameCount](const auto& kv) { return kv.second.lastUsedFrame != frameCount; });
         }
     }
 
@@ -450,6 +440,90 @@ namespace DockingDetails
         }
     }
 
+    // True if the current window is entirely clipped, or outside its viewport
+    // (a tab which is not selected in its dock node never gets here: ImGui::Begin() returns false)
+    static bool IsCurrentWindowHidden()
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if (window->InnerClipRect.GetWidth() <= 0.f || window->InnerClipRect.GetHeight() <= 0.f)
+            return true;
+        ImGuiViewport* viewport = window->Viewport;
+        if (viewport != nullptr && !ImRect(viewport->Pos, viewport->Pos + viewport->Size).Overlaps(window->Rect()))
+            return true;
+        return false;
+    }
+
+    static bool IsSameTexture(const ImTextureRef& a, const ImTextureRef& b)
+    {
+        return a._TexData == b._TexData && a._TexID == b._TexID;
+    }
+
+    // Calls the dockable window GuiFunction (inside its Begin/End), unless
+    // - skipGuiWhenHidden is set, and the window is hidden
+    // - maxRefreshRate is set, and the window was refreshed recently: its last draw commands are replayed instead
+    //   (unless GuiFunction created child windows)
+    // When GuiFunction is not called, a Dummy keeps the window content size (and thus its scroll position)
+    static void ShowDockableWindowGui(DockableWindow& dockableWindow)
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        if (dockableWindow.skipGuiWhenHidden && IsCurrentWindowHidden())
+        {
+            ImGui::Dummy(window->ContentSize);
+            return;
+        }
+        if (dockableWindow.maxRefreshRate <= 0.f)
+        {
+            dockableWindow.GuiFunction();
+            return;
+        }
+
+        assert(GHelloImGui != nullptr);
+        HelloImGuiContext& h = *GHelloImGui;
+        DockableWindowRenderCache& cache = h.DockableWindowsRenderCaches[window->ID];
+        ImGuiContext& g = *GImGui;
+        double now = ImGui::GetTime();
+        ImTextureRef fontTexRef = ImGui::GetIO().Fonts->TexRef;
+
+        bool isInteracting = ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows | ImGuiHoveredFlags_AllowWhenBlockedByActiveItem)
+                             || ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows)
+                             || (g.ActiveIdWindow != nullptr && g.ActiveIdWindow->RootWindow == window->RootWindow);
+        bool hasWindowChanged = (cache.windowPos.x != window->Pos.x) || (cache.windowPos.y != window->Pos.y)
+                                || (cache.windowSize.x != window->Size.x) || (cache.windowSize.y != window->Size.y)
+                                || (cache.windowScroll.x != window->Scroll.x) || (cache.windowScroll.y != window->Scroll.y)
+                                || !IsSameTexture(cache.fontTexRef, fontTexRef)
+                                || (cache.imagesGeneration != internal::ImageTexturesGeneration());
+        bool wasRefreshedRecently = (now - cache.lastGuiTime) < 1.0 / (double)dockableWindow.maxRefreshRate;
+
+        if (cache.drawCommands.IsValid() && wasRefreshedRecently && !isInteracting && !hasWindowChanged)
+        {
+            cache.drawCommands.Replay(window->DrawList);
+            // The replayed images shall not be evicted from the ImageFromAsset cache
+            internal::TouchImages(cache.usedImageKeys);
+            ImGui::Dummy(cache.contentSize);
+            return;
+        }
+
+        ImVec2 cursorStartPos = ImGui::GetCursorScreenPos();
+        int nbChildWindowsBefore = window->DC.ChildWindows.Size;
+        cache.usedImageKeys.clear();
+        std::vector<std::string>* previousImagesRecorder = internal::SetUsedImagesRecorder(&cache.usedImageKeys);
+        cache.drawCommands.BeginCapture(window->DrawList);
+        dockableWindow.GuiFunction();
+        cache.drawCommands.EndCapture(window->DrawList);
+        internal::SetUsedImagesRecorder(previousImagesRecorder);
+        // Child windows (BeginChild, scrolling tables, ...) have their own draw lists, and would not be
+        // submitted on the replayed frames: such a window is refreshed at every frame
+        if (window->DC.ChildWindows.Size > nbChildWindowsBefore)
+            cache.drawCommands.Invalidate();
+        cache.lastGuiTime = now;
+        cache.windowPos = window->Pos;
+        cache.windowSize = window->Size;
+        cache.windowScroll = window->Scroll;
+        cache.fontTexRef = fontTexRef;
+        cache.imagesGeneration = internal::ImageTexturesGeneration();
+        cache.contentSize = window->DC.CursorMaxPos - cursorStartPos;
+    }
+
     void ShowDockableWindows(std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
     {
         bool wereAllDockableWindowsInited = (ImGui::GetFrameCount() > 1);
@@ -501,7 +575,10 @@ namespace DockingDetails
                     }
 
                     if (not_collapsed && dockableWindow->GuiFunction)
-                        dockableWindow->GuiFunction();
+                    {
+                        GuiCostScope guiCostScope(dockableWindow->label.c_str(), GuiCostKind::DockableWindow);
+                        ShowDockableWindowGui(*dockableWindow);
+                    }
                     if (!dockableWindow->dockingParams.dockingSplits.empty())
                     {
                         ImplProviderNestedDockspace(dockableWindow);
@@ -519,6 +596,7 @@ namespace DockingDetails
                 }
                 else
                 {
+                    GuiCostScope guiCostScope(dockableWindow->label.c_str(), GuiCostKind::DockableWindow);
                     dockableWindow->GuiFunction();
                 }
             }
@@ -822,14 +900,18 @@ namespace DockingDetails
 
 }  // namespace DockingDetails
 
+// Searches by label, or else by "###" id (the same rules as DockableWindowRegistry::Find)
 static std::shared_ptr<DockableWindow> GetDockableWindowRec(
-    const std::string& label, std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
+    const std::string& key, bool searchById, std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
 {
     for (auto& dockableWindow : dockableWindows)
     {
-        if (dockableWindow->label == label)
+        if (dockableWindow == nullptr)
+            continue;
+        bool matches = searchById ? (DockableWindowIdPart(dockableWindow->label) == key) : (dockableWindow->label == key);
+        if (matches)
             return dockableWindow;
-        auto dockableWindowRec = GetDockableWindowRec(label, dockableWindow->dockingParams.dockableWindows);
+        auto dockableWindowRec = GetDockableWindowRec(key, searchById, dockableWindow->dockingParams.dockableWindows);
         if (dockableWindowRec)
             return dockableWindowRec;
     }
@@ -838,7 +920,24 @@ static std::shared_ptr<DockableWindow> GetDockableWindowRec(
 
 std::shared_ptr<DockableWindow> DockingParams::dockableWindowOfName(const std::string& name)
 {
-    return GetDockableWindowRec(name, dockableWindows);
+    // The dockable windows of the running app are indexed (see DockableWindowRegistry)
+    bool isIndexed = GHelloImGui != nullptr && IsUsingHelloImGui() && this == &GetRunnerParams()->dockingParams;
+    if (isIndexed)
+    {
+        auto location = GHelloImGui->DockableWindowsRegistry.Find(*this, name);
+        if (location.has_value())
+            return location->window;
+    }
+
+    // Fallback to a linear search: the window may have been added or renamed directly in the vectors
+    // since the registry was last validated (e.g. earlier in this frame)
+    auto dockableWindow = GetDockableWindowRec(name, false, dockableWindows);
+    std::string idPart = DockableWindowIdPart(name);
+    if (dockableWindow == nullptr && !idPart.empty())
+        dockableWindow = GetDockableWindowRec(idPart, true, dockableWindows);
+    if (dockableWindow != nullptr && isIndexed)
+        GHelloImGui->DockableWindowsRegistry.Validate(*this);
+    return dockableWindow;
 }
 
 bool DockingParams::focusDockableWindow(const std::string& windowName)
@@ -937,49 +1036,27 @@ namespace AddDockableWindowHelper
         }
     }
 
-    static bool InsertDockableWindow(std::shared_ptr<DockableWindow> dockableWindow,
-                                     std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
+    // Finds the correct place to insert the dockable window (using the registry, instead of searching
+    // through the recursive dockable windows): under the window whose label is the dockspace name,
+    // or else under the window whose docking splits create this dockspace
+    static bool InsertDockableWindow(std::shared_ptr<DockableWindow> dockableWindow, DockingParams& dockingParams)
     {
         assert(dockableWindow != nullptr);
-        // find the correct place to insert the dockable window, searching through the recursive dockable
-        // windows to find the correct dockspace
+        HelloImGuiContext& h = *GHelloImGui;
+        auto& registry = h.DockableWindowsRegistry;
         if (dockableWindow->dockSpaceName == "MainDockSpace")
         {
-            dockableWindows.push_back(std::move(dockableWindow));
+            registry.Append(dockingParams, nullptr, std::move(dockableWindow));
             return true;
         }
 
-        for (auto& dockableWindowInList : dockableWindows)
-        {
-            if (dockableWindowInList->label == dockableWindow->dockSpaceName)
-            {
-                dockableWindowInList->dockingParams.dockableWindows.push_back(std::move(dockableWindow));
-                return true;
-            }
-        }
-
-        for (auto& dockableWindowInList : dockableWindows)
-        {
-            if (!dockableWindowInList->dockingParams.dockableWindows.empty() &&
-                InsertDockableWindow(dockableWindow, dockableWindowInList->dockingParams.dockableWindows))
-                return true;
-        }
-
-        // else this window must be a split window
-        // so check dockingParams.dockingSplits for a dockSpaceName == newDock
-        for (auto& dockableWindowInList : dockableWindows)
-        {
-            for (const auto& dockingSplit : dockableWindowInList->dockingParams.dockingSplits)
-            {
-                if (dockingSplit.newDock == dockableWindow->dockSpaceName)
-                {
-                    dockableWindowInList->dockingParams.dockableWindows.push_back(std::move(dockableWindow));
-                    return true;
-                }
-            }
-        }
-
-        return false;
+        auto parent = registry.Find(dockingParams, dockableWindow->dockSpaceName);
+        if (!parent.has_value())
+            parent = registry.FindSplitOwner(dockingParams, dockableWindow->dockSpaceName);
+        if (!parent.has_value())
+            return false;
+        registry.Append(dockingParams, &parent.value(), std::move(dockableWindow));
+        return true;
     }
 
     static void CleanupNullDockableWindows(std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
@@ -998,17 +1075,19 @@ namespace AddDockableWindowHelper
         assert(GHelloImGui != nullptr);
         HelloImGuiContext& h = *GHelloImGui;
 
+        // Take into account the windows which were added, removed or renamed directly in the vectors
+        h.DockableWindowsRegistry.Validate(HelloImGui::GetRunnerParams()->dockingParams);
+
         // Add the dockable windows that have been added as dummy to ImGui to HelloImGui
         for (auto& dockableWindow : h.DockableWindowsToAdd)
         {
             if (dockableWindow.dockableWindow->state == DockableWindowAdditionState::AddedAsDummyToImGui)
             {
-                if (!InsertDockableWindow(dockableWindow.dockableWindow,
-                                          HelloImGui::GetRunnerParams()->dockingParams.dockableWindows))
+                auto& dockingParams = HelloImGui::GetRunnerParams()->dockingParams;
+                if (!InsertDockableWindow(dockableWindow.dockableWindow, dockingParams))
                 {
                     // Add to the base
-                    HelloImGui::GetRunnerParams()->dockingParams.dockableWindows.push_back(
-                        dockableWindow.dockableWindow);
+                    h.DockableWindowsRegistry.Append(dockingParams, nullptr, dockableWindow.dockableWindow);
                 }
                 // Regardless just move on to the next state
                 dockableWindow.dockableWindow->state = DockableWindowAdditionState::AddedToHelloImGui;
@@ -1027,16 +1106,16 @@ namespace AddDockableWindowHelper
             h.DockableWindowsToAdd.end());
 
         // Remove the dockable windows that have been requested to be removed
-        auto& dockableWindows = HelloImGui::GetRunnerParams()->dockingParams.dockableWindows;
+        auto& dockingParams = HelloImGui::GetRunnerParams()->dockingParams;
         for (const auto& dockableWindowName : h.DockableWindowsToRemove)
         {
-            dockableWindows.erase(std::remove_if(dockableWindows.begin(),
-                                                 dockableWindows.end(),
-                                                 [&dockableWindowName](auto& dockableWindow)
-                                                 { return dockableWindow->label == dockableWindowName; }),
-                                  dockableWindows.end());
+            while (h.DockableWindowsRegistry.Remove(dockingParams, dockableWindowName))
+                ;
         }
+        if (!h.DockableWindowsToRemove.empty())
+            h.ViewMenuModels.clear();  // the removed windows may own dockableWindows vectors
         h.DockableWindowsToRemove.clear();
+        auto& dockableWindows = dockingParams.dockableWindows;
 
         // check if any dockable windows are null (recursively)
         CleanupNullDockableWindows(dockableWindows);
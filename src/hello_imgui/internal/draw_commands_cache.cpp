@@ -0,0 +1,86 @@
+#include "hello_imgui/internal/draw_commands_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+namespace HelloImGui
+{
+    void DrawCommandsCache::BeginCapture(const ImDrawList* drawList)
+    {
+        mStartIdx = drawList->IdxBuffer.Size;
+        mStartCmdCount = drawList->CmdBuffer.Size;
+        mStartLastCmdHasCallback = (mStartCmdCount > 0) && (drawList->CmdBuffer.back().UserCallback != nullptr);
+        mIsValid = false;
+    }
+
+    bool DrawCommandsCache::EndCapture(const ImDrawList* drawList)
+    {
+        mSegments.clear();
+        mVertices.clear();
+        mIndices.clear();
+        mIsValid = false;
+
+        // Draw commands may be merged with the command that was current when the capture began:
+        // capture the elements by index range, not by command
+        for (int idxCmd = 0; idxCmd < drawList->CmdBuffer.Size; ++idxCmd)
+        {
+            const ImDrawCmd& cmd = drawList->CmdBuffer[idxCmd];
+            if (cmd.UserCallback != nullptr)
+            {
+                // AddCallback() reuses the current command when it is empty
+                bool isCapturedCallback = (idxCmd >= mStartCmdCount)
+                                          || (idxCmd == mStartCmdCount - 1 && !mStartLastCmdHasCallback);
+                if (isCapturedCallback)
+                    return false;
+                continue;
+            }
+            int idxBegin = std::max((int)cmd.IdxOffset, mStartIdx);
+            int idxEnd = (int)(cmd.IdxOffset + cmd.ElemCount);
+            if (idxEnd <= idxBegin)
+                continue;
+
+            unsigned int vtxMin = UINT32_MAX, vtxMax = 0;
+            for (int i = idxBegin; i < idxEnd; ++i)
+            {
+                unsigned int vtx = cmd.VtxOffset + (unsigned int)drawList->IdxBuffer[i];
+                vtxMin = std::min(vtxMin, vtx);
+                vtxMax = std::max(vtxMax, vtx);
+            }
+
+            Segment segment;
+            segment.clipRect = cmd.ClipRect;
+            segment.texRef = cmd.TexRef;
+            segment.vtxBegin = (int)mVertices.size();
+            segment.vtxCount = (int)(vtxMax - vtxMin + 1);
+            segment.idxBegin = (int)mIndices.size();
+            segment.idxCount = idxEnd - idxBegin;
+            mVertices.insert(mVertices.end(), drawList->VtxBuffer.Data + vtxMin, drawList->VtxBuffer.Data + vtxMax + 1);
+            for (int i = idxBegin; i < idxEnd; ++i)
+                mIndices.push_back((ImDrawIdx)(cmd.VtxOffset + (unsigned int)drawList->IdxBuffer[i] - vtxMin));
+            mSegments.push_back(segment);
+        }
+        mIsValid = true;
+        return true;
+    }
+
+    void DrawCommandsCache::Replay(ImDrawList* drawList) const
+    {
+        IM_ASSERT(mIsValid);
+        for (const Segment& segment : mSegments)
+        {
+            drawList->PushClipRect(ImVec2(segment.clipRect.x, segment.clipRect.y), ImVec2(segment.clipRect.z, segment.clipRect.w));
+            drawList->PushTexture(segment.texRef);
+            drawList->PrimReserve(segment.idxCount, segment.vtxCount);
+            memcpy(drawList->_VtxWritePtr, &mVertices[(size_t)segment.vtxBegin], (size_t)segment.vtxCount * sizeof(ImDrawVert));
+            drawList->_VtxWritePtr += segment.vtxCount;
+            for (int i = 0; i < segment.idxCount; ++i)
+                drawList->_IdxWritePtr[i] = (ImDrawIdx)(drawList->_VtxCurrentIdx + mIndices[(size_t)(segment.idxBegin + i)]);
+            drawList->_IdxWritePtr += segment.idxCount;
+            drawList->_VtxCurrentIdx += (unsigned int)segment.vtxCount;
+            drawList->PopTexture();
+            drawList->PopClipRect();
+        }
+    }
+}
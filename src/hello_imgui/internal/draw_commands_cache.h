@@ -0,0 +1,60 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    // DrawCommandsCache captures the primitives added to a draw list between BeginCapture() and EndCapture(),
+    // so that they can be appended again to the draw list on later frames (see Replay()),
+    // without calling the code that produced them.
+    class DrawCommandsCache
+    {
+    public:
+        void BeginCapture(const ImDrawList* drawList);
+        // Returns false if the captured commands cannot be replayed (e.g. they contain user callbacks)
+        bool EndCapture(const ImDrawList* drawList);
+
+        bool IsValid() const { return mIsValid; }
+        void Invalidate() { mIsValid = false; }
+
+        void Replay(ImDrawList* drawList) const;
+
+    private:
+        // The elements of one draw command, with indices relative to the segment first vertex
+        struct Segment
+        {
+            ImVec4 clipRect;
+            ImTextureRef texRef;
+            int vtxBegin = 0, vtxCount = 0;
+            int idxBegin = 0, idxCount = 0;
+        };
+
+        std::vector<Segment> mSegments;
+        std::vector<ImDrawVert> mVertices;
+        std::vector<ImDrawIdx> mIndices;
+        int mStartIdx = 0;
+        int mStartCmdCount = 0;
+        bool mStartLastCmdHasCallback = false;
+        bool mIsValid = false;
+    };
+
+
+    // Render throttling state of a dockable window (see DockableWindow.maxRefreshRate)
+    struct DockableWindowRenderCache
+    {
+        DrawCommandsCache drawCommands;
+        double lastGuiTime = -1.;
+        // The cache is invalid if the window moved, was resized or scrolled, or if the font texture changed
+        ImVec2 windowPos, windowSize, windowScroll;
+        ImTextureRef fontTexRef;
+        ImVec2 contentSize;  // Size of the items submitted by GuiFunction
+        // Keys of the images displayed by GuiFunction (see ImageFromAsset): the cache is invalid
+        // if an image texture was freed or loaded since the capture (see internal::ImageTexturesGeneration())
+        std::vector<std::string> usedImageKeys;
+        uint64_t imagesGeneration = 0;
+    };
+}
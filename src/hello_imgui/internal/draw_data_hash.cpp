@@ -0,0 +1,169 @@
+#include "hello_imgui/internal/draw_data_hash.h"
+
+#include <cstring>
+
+namespace HelloImGui
+{
+    static constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ull;
+
+    static inline uint64_t HashMix(uint64_t h, uint64_t v)
+    {
+        h = (h ^ v) * kHashMultiplier;
+        return h ^ (h >> 32);
+    }
+
+    static inline uint64_t ReadU64(const unsigned char* p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // Hashes a buffer 32 bytes at a time, on 4 independent lanes (so that the multiplications can be pipelined)
+    static uint64_t HashBytes(uint64_t h, const void* data, size_t size)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        const size_t totalSize = size;
+        uint64_t h0 = h, h1 = h + 1, h2 = h + 2, h3 = h + 3;
+        while (size >= 32)
+        {
+            h0 = HashMix(h0, ReadU64(p));
+            h1 = HashMix(h1, ReadU64(p + 8));
+            h2 = HashMix(h2, ReadU64(p + 16));
+            h3 = HashMix(h3, ReadU64(p + 24));
+            p += 32;
+            size -= 32;
+        }
+        while (size >= 8)
+        {
+            h0 = HashMix(h0, ReadU64(p));
+            p += 8;
+            size -= 8;
+        }
+        if (size > 0)
+        {
+            uint64_t tail = 0;
+            memcpy(&tail, p, size);
+            h1 = HashMix(h1, tail);
+        }
+        return HashMix(HashMix(HashMix(HashMix((uint64_t)totalSize, h0), h1), h2), h3);
+    }
+
+    static inline uint64_t HashFloat(uint64_t h, float f)
+    {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return HashMix(h, bits);
+    }
+
+    static inline uint64_t HashPointer(uint64_t h, const void* ptr)
+    {
+        return HashMix(h, (uint64_t)(uintptr_t)ptr);
+    }
+
+    uint64_t ComputeDrawListHash(const ImDrawList* drawList, bool* outHasUserCallbacks)
+    {
+        bool hasUserCallbacks = false;
+        uint64_t h = 0x2545F4914F6CDD1Dull;
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+        {
+            if (cmd.UserCallback != nullptr && cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                hasUserCallbacks = true;
+            h = HashFloat(h, cmd.ClipRect.x);
+            h = HashFloat(h, cmd.ClipRect.y);
+            h = HashFloat(h, cmd.ClipRect.z);
+            h = HashFloat(h, cmd.ClipRect.w);
+            h = HashPointer(h, cmd.TexRef._TexData);
+            h = HashMix(h, (uint64_t)cmd.TexRef._TexID);
+            h = HashMix(h, ((uint64_t)cmd.VtxOffset << 32) | (uint64_t)cmd.IdxOffset);
+            h = HashMix(h, (uint64_t)cmd.ElemCount);
+            h = HashMix(h, (uint64_t)(uintptr_t)cmd.UserCallback);
+        }
+        h = HashBytes(h, drawList->VtxBuffer.Data, (size_t)drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+        h = HashBytes(h, drawList->IdxBuffer.Data, (size_t)drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+        if (outHasUserCallbacks != nullptr)
+            *outHasUserCallbacks = hasUserCallbacks;
+        return h;
+    }
+
+    bool ComputeDrawDataHash(const ImDrawData* drawData, ImVec4 clearColor, uint64_t* outHash)
+    {
+        if (drawData == nullptr || !drawData->Valid)
+            return false;
+        if (drawData->Textures != nullptr)
+            for (const ImTextureData* tex : *drawData->Textures)
+                if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates || tex->Status == ImTextureStatus_WantDestroy)
+                    return false;
+
+        uint64_t h = 0x51ED27FB4A3C1D03ull;
+        h = HashFloat(h, clearColor.x);
+        h = HashFloat(h, clearColor.y);
+        h = HashFloat(h, clearColor.z);
+        h = HashFloat(h, clearColor.w);
+        h = HashFloat(h, drawData->DisplayPos.x);
+        h = HashFloat(h, drawData->DisplayPos.y);
+        h = HashFloat(h, drawData->DisplaySize.x);
+        h = HashFloat(h, drawData->DisplaySize.y);
+        h = HashFloat(h, drawData->FramebufferScale.x);
+        h = HashFloat(h, drawData->FramebufferScale.y);
+        h = HashMix(h, (uint64_t)drawData->CmdListsCount);
+
+        for (const ImDrawList* drawList : drawData->CmdLists)
+        {
+            bool hasUserCallbacks;
+            h = HashMix(h, ComputeDrawListHash(drawList, &hasUserCallbacks));
+            if (hasUserCallbacks)
+                return false;
+        }
+        *outHash = h;
+        return true;
+    }
+
+
+    size_t DrawListByteSize(const ImDrawList* drawList)
+    {
+        return (size_t)drawList->CmdBuffer.Size * sizeof(ImDrawCmd)
+            + (size_t)drawList->VtxBuffer.Size * sizeof(ImDrawVert)
+            + (size_t)drawList->IdxBuffer.Size * sizeof(ImDrawIdx);
+    }
+
+    DrawListsDelta DrawListsDeltaTracker::Update(const ImDrawData* drawData)
+    {
+        DrawListsDelta r;
+        if (drawData == nullptr || !drawData->Valid)
+            return r;
+
+        ImVec4 displayRect(drawData->DisplayPos.x, drawData->DisplayPos.y, drawData->DisplaySize.x, drawData->DisplaySize.y);
+        r.hasDisplayChanged = mIsFirstUpdate
+            || displayRect.x != mDisplayRect.x || displayRect.y != mDisplayRect.y
+            || displayRect.z != mDisplayRect.z || displayRect.w != mDisplayRect.w;
+        mDisplayRect = displayRect;
+        mIsFirstUpdate = false;
+
+        r.nbDrawLists = drawData->CmdListsCount;
+        for (int i = 0; i < r.nbDrawLists; ++i)
+        {
+            const ImDrawList* drawList = drawData->CmdLists[i];
+            uint64_t hash = ComputeDrawListHash(drawList);
+            size_t byteSize = DrawListByteSize(drawList);
+            // Draw lists are compared by position in the draw data
+            bool hasChanged = (i >= (int)mHashes.size()) || (mHashes[(size_t)i] != hash);
+            if (i < (int)mHashes.size())
+                mHashes[(size_t)i] = hash;
+            else
+                mHashes.push_back(hash);
+            r.totalBytes += byteSize;
+            if (hasChanged)
+            {
+                ++r.nbChangedDrawLists;
+                r.changedBytes += byteSize;
+            }
+        }
+        if (mHashes.size() > (size_t)r.nbDrawLists)
+        {
+            r.hasRemovedDrawLists = true;
+            mHashes.resize((size_t)r.nbDrawLists);
+        }
+        return r;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace HelloImGui
+{
+    // Computes a fast 64 bits hash of the draw data (vertex, index and command buffers, display size & scale),
+    // and of the clear color, so that two frames with identical content can be detected.
+    //
+    // Returns false if the draw data cannot be compared by a hash, i.e. if its rendering
+    // may differ even with identical buffers:
+    //     - it contains user callbacks (other than ImDrawCallback_ResetRenderState)
+    //     - some textures have pending updates (creation, update or destruction)
+    bool ComputeDrawDataHash(const ImDrawData* drawData, ImVec4 clearColor, uint64_t* outHash);
+
+    // Hash of one draw list (commands, vertices and indices)
+    uint64_t ComputeDrawListHash(const ImDrawList* drawList, bool* outHasUserCallbacks = nullptr);
+
+    // Size of the commands, vertices and indices of a draw list
+    size_t DrawListByteSize(const ImDrawList* drawList);
+
+
+    // What changed in the draw data since the previous frame
+    struct DrawListsDelta
+    {
+        int nbDrawLists = 0;
+        int nbChangedDrawLists = 0;
+        bool hasRemovedDrawLists = false;
+        bool hasDisplayChanged = false;  // Display position or size
+        size_t totalBytes = 0;           // Size of all the draw lists
+        size_t changedBytes = 0;         // Size of the changed draw lists
+
+        bool HasChanges() const { return nbChangedDrawLists > 0 || hasRemovedDrawLists || hasDisplayChanged; }
+    };
+
+    // DrawListsDeltaTracker hashes each draw list of successive frames,
+    // in order to find which ones changed (e.g. to send only those to a remote display)
+    class DrawListsDeltaTracker
+    {
+    public:
+        DrawListsDelta Update(const ImDrawData* drawData);
+
+    private:
+        std::vector<uint64_t> mHashes;
+        ImVec4 mDisplayRect;
+        bool mIsFirstUpdate = true;
+    };
+}
@@ -0,0 +1,235 @@
+#include "hello_imgui/internal/frame_profiler.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/trace_exporter.h"
+#include "imgui.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace HelloImGui
+{
+    const char* FramePhaseName(FramePhase phase)
+    {
+        switch (phase)
+        {
+            case FramePhase::HandleLayout: return "Layout";
+            case FramePhase::HandleIdling: return "Idling";
+            case FramePhase::PollEvents: return "Poll events";
+            case FramePhase::NewFrame: return "NewFrame";
+            case FramePhase::RenderGui: return "Gui";
+            case FramePhase::RenderAndSwap: return "Render & Swap";
+            case FramePhase::AfterSwap: return "AfterSwap";
+            default: return "Unknown";
+        }
+    }
+
+    double FramePhaseTimings::TotalDuration() const
+    {
+        double total = 0.;
+        for (double duration : phaseDurations)
+            total += duration;
+        return total;
+    }
+
+    std::vector<FramePhaseTimings> FramePhaseTimingsHistory(int maxFrames)
+    {
+        return FrameProfiler::History(maxFrames);
+    }
+
+
+    namespace FrameProfiler
+    {
+        constexpr int NbPhases = (int)FramePhase::Count;
+
+        // A slot of the ring buffer, protected by a sequence lock:
+        // `sequence` is odd while the slot is being written, and equals 2 * (frameIndex + 1) once published.
+        // Values are stored as relaxed atomics, so that a reader never races with the writer;
+        // it simply discards the slot if the sequence changed while it was reading.
+        struct RingSlot
+        {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<double> frameStartTime{0.};
+            std::atomic<double> phaseDurations[NbPhases] = {};
+        };
+
+        struct FrameProfilerStatics
+        {
+            RingSlot ring[HistoryCapacity];
+            std::atomic<uint64_t> nbPublishedFrames{0};
+
+            // Frame being recorded: only accessed by the main loop
+            FramePhaseTimings currentFrame;
+            double lastPhaseEndTime = 0.;
+            bool isRecording = false;
+        };
+
+        static FrameProfilerStatics gStatics;
+
+
+        void BeginFrame()
+        {
+            double now = Internal::ClockSeconds();
+            gStatics.currentFrame = FramePhaseTimings();
+            gStatics.currentFrame.frameStartTime = now;
+            gStatics.lastPhaseEndTime = now;
+            gStatics.isRecording = true;
+        }
+
+        void EndPhase(FramePhase phase)
+        {
+            if (!gStatics.isRecording)
+                return;
+            double now = Internal::ClockSeconds();
+            gStatics.currentFrame.phaseDurations[(int)phase] += now - gStatics.lastPhaseEndTime;
+            gStatics.lastPhaseEndTime = now;
+        }
+
+        void CancelFrame()
+        {
+            gStatics.isRecording = false;
+        }
+
+        void EndFrame()
+        {
+            if (!gStatics.isRecording)
+                return;
+            gStatics.isRecording = false;
+
+            uint64_t frameIndex = gStatics.nbPublishedFrames.load(std::memory_order_relaxed);
+            RingSlot& slot = gStatics.ring[frameIndex % HistoryCapacity];
+
+            slot.sequence.store(2 * frameIndex + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot.frameStartTime.store(gStatics.currentFrame.frameStartTime, std::memory_order_relaxed);
+            for (int i = 0; i < NbPhases; ++i)
+                slot.phaseDurations[i].store(gStatics.currentFrame.phaseDurations[i], std::memory_order_relaxed);
+
+            slot.sequence.store(2 * frameIndex + 2, std::memory_order_release);
+            gStatics.nbPublishedFrames.store(frameIndex + 1, std::memory_order_release);
+
+            if (TraceExporter::IsActive())
+            {
+                const FramePhaseTimings& frame = gStatics.currentFrame;
+                TraceExporter::AddCompleteEvent("Frame", "frame", frame.frameStartTime, frame.TotalDuration());
+                double phaseStartTime = frame.frameStartTime;
+                for (int i = 0; i < NbPhases; ++i)
+                {
+                    double duration = frame.phaseDurations[i];
+                    if (duration > 0.)
+                        TraceExporter::AddCompleteEvent(FramePhaseName((FramePhase)i), "phase", phaseStartTime, duration);
+                    phaseStartTime += duration;
+                }
+            }
+        }
+
+        std::vector<FramePhaseTimings> History(int maxFrames)
+        {
+            std::vector<FramePhaseTimings> r;
+            uint64_t nbPublished = gStatics.nbPublishedFrames.load(std::memory_order_acquire);
+            uint64_t nbFrames = std::min<uint64_t>(nbPublished, (uint64_t)std::max(maxFrames, 0));
+            nbFrames = std::min<uint64_t>(nbFrames, HistoryCapacity);
+            r.reserve(nbFrames);
+
+            for (uint64_t frameIndex = nbPublished - nbFrames; frameIndex < nbPublished; ++frameIndex)
+            {
+                const RingSlot& slot = gStatics.ring[frameIndex % HistoryCapacity];
+                uint64_t expectedSequence = 2 * frameIndex + 2;
+                if (slot.sequence.load(std::memory_order_acquire) != expectedSequence)
+                    continue; // already overwritten by a newer frame
+
+                FramePhaseTimings timings;
+                timings.frameStartTime = slot.frameStartTime.load(std::memory_order_relaxed);
+                for (int i = 0; i < NbPhases; ++i)
+                    timings.phaseDurations[i] = slot.phaseDurations[i].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != expectedSequence)
+                    continue; // overwritten while we were reading
+
+                r.push_back(timings);
+            }
+            return r;
+        }
+
+        ImU32 PhaseColor(FramePhase phase)
+        {
+            switch (phase)
+            {
+                case FramePhase::HandleLayout: return IM_COL32(150, 150, 150, 255);
+                case FramePhase::HandleIdling: return IM_COL32(70, 70, 90, 255);
+                case FramePhase::PollEvents: return IM_COL32(90, 160, 230, 255);
+                case FramePhase::NewFrame: return IM_COL32(80, 200, 200, 255);
+                case FramePhase::RenderGui: return IM_COL32(110, 200, 90, 255);
+                case FramePhase::RenderAndSwap: return IM_COL32(230, 160, 60, 255);
+                case FramePhase::AfterSwap: return IM_COL32(200, 90, 200, 255);
+                default: return IM_COL32(255, 255, 255, 255);
+            }
+        }
+
+        void ShowTimeline(ImVec2 size)
+        {
+            float barWidth = std::max(2.f, ImGui::GetFontSize() * 0.2f);
+            int maxBars = std::max(1, (int)(size.x / barWidth));
+            auto frames = History(maxBars);
+
+            ImVec2 topLeft = ImGui::GetCursorScreenPos();
+            ImVec2 bottomRight(topLeft.x + size.x, topLeft.y + size.y);
+            ImGui::InvisibleButton("##FrameProfilerTimeline", size);
+            bool isHovered = ImGui::IsItemHovered();
+
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            drawList->AddRectFilled(topLeft, bottomRight, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+            // The vertical scale shows at least 1/30s, so that the 60 FPS budget is always visible
+            double maxDuration = 1. / 30.;
+            for (const auto& frame : frames)
+                maxDuration = std::max(maxDuration, frame.TotalDuration());
+            auto durationToHeight = [&](double duration) { return (float)(duration / maxDuration) * size.y; };
+
+            int hoveredFrameIdx = -1;
+            int nbFrames = (int)frames.size();
+            for (int i = 0; i < nbFrames; ++i)
+            {
+                // Newest frames are on the right
+                float x0 = bottomRight.x - (float)(nbFrames - i) * barWidth;
+                float x1 = x0 + barWidth - 1.f;
+                float y = bottomRight.y;
+                for (int phase = 0; phase < NbPhases; ++phase)
+                {
+                    float h = durationToHeight(frames[i].phaseDurations[phase]);
+                    if (h <= 0.f)
+                        continue;
+                    drawList->AddRectFilled(ImVec2(x0, y - h), ImVec2(x1, y), PhaseColor((FramePhase)phase));
+                    y -= h;
+                }
+                if (isHovered)
+                {
+                    float mouseX = ImGui::GetIO().MousePos.x;
+                    if (mouseX >= x0 && mouseX < x0 + barWidth)
+                        hoveredFrameIdx = i;
+                }
+            }
+
+            // 60 FPS budget line
+            float yBudget = bottomRight.y - durationToHeight(1. / 60.);
+            drawList->AddLine(ImVec2(topLeft.x, yBudget), ImVec2(bottomRight.x, yBudget), IM_COL32(255, 80, 80, 160));
+
+            if (hoveredFrameIdx >= 0)
+            {
+                const auto& frame = frames[hoveredFrameIdx];
+                ImGui::BeginTooltip();
+                ImGui::Text("Frame: %.2f ms", frame.TotalDuration() * 1000.);
+                ImGui::Separator();
+                for (int phase = 0; phase < NbPhases; ++phase)
+                {
+                    ImGui::TextColored(
+                        ImGui::ColorConvertU32ToFloat4(PhaseColor((FramePhase)phase)),
+                        "%-14s %7.3f ms", FramePhaseName((FramePhase)phase), frame.phaseDurations[phase] * 1000.);
+                }
+                ImGui::EndTooltip();
+            }
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+
+#include <vector>
+
+namespace HelloImGui
+{
+    // FrameProfiler records the duration of each phase of the frames rendered by AbstractRunner
+    // into a fixed size, lock-free ring buffer (single producer: the main loop; any number of readers).
+    //
+    // Usage inside the main loop:
+    //     FrameProfiler::BeginFrame();
+    //     ... (layout)    FrameProfiler::EndPhase(FramePhase::HandleLayout);
+    //     ... (idling)    FrameProfiler::EndPhase(FramePhase::HandleIdling);
+    //     ...
+    //     FrameProfiler::EndFrame();     // publishes the frame timings
+    // or FrameProfiler::CancelFrame();  // if the frame was skipped (idling by early return)
+    namespace FrameProfiler
+    {
+        // Number of frames kept in the ring buffer
+        constexpr int HistoryCapacity = 512;
+
+        void BeginFrame();
+        // Stores the time elapsed since the previous phase end (or since BeginFrame) as the duration of `phase`
+        void EndPhase(FramePhase phase);
+        void EndFrame();
+        void CancelFrame();
+
+        // Returns the last published frames (oldest first)
+        std::vector<FramePhaseTimings> History(int maxFrames);
+
+        // Color used to display a phase in the timeline
+        ImU32 PhaseColor(FramePhase phase);
+
+        // Draws a stacked per-frame timeline (one vertical bar per frame) at the cursor position,
+        // with a tooltip that details the phases of the hovered frame
+        void ShowTimeline(ImVec2 size);
+    }
+}
@@ -0,0 +1,92 @@
+#include "hello_imgui/internal/frame_stats_ring.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace HelloImGui
+{
+    void FrameStatsRing::AddFrame(double timestamp)
+    {
+        mTimestamps[mNbFramesTotal % Capacity] = timestamp;
+        ++mNbFramesTotal;
+    }
+
+    int FrameStatsRing::NbStoredFrames() const
+    {
+        return (int)std::min<uint64_t>(mNbFramesTotal, Capacity);
+    }
+
+    double FrameStatsRing::TimestampAt(int idx) const
+    {
+        uint64_t oldestFrame = mNbFramesTotal - (uint64_t)NbStoredFrames();
+        return mTimestamps[(oldestFrame + (uint64_t)idx) % Capacity];
+    }
+
+    float FrameStatsRing::FrameRate(double durationForMean) const
+    {
+        int nbFrames = NbStoredFrames();
+        if (nbFrames <= 1)
+            return 0.f;
+
+        int lastFrameIdx = nbFrames - 1;
+        double lastFrameTime = TimestampAt(lastFrameIdx);
+
+        // Find the most recent frame that is older than durationForMean
+        // (timestamps are increasing, so that we can use a binary search)
+        int lo = 0, hi = lastFrameIdx;
+        while (lo < hi)
+        {
+            int mid = (lo + hi + 1) / 2;
+            if (lastFrameTime - TimestampAt(mid) > durationForMean)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        int firstFrameIdx = lo;
+        if (firstFrameIdx == lastFrameIdx)
+            return 0.f;
+
+        double totalTime = lastFrameTime - TimestampAt(firstFrameIdx);
+        if (totalTime <= 0.)
+            return 0.f;
+        int nbIntervals = lastFrameIdx - firstFrameIdx;
+        return (float)((double)nbIntervals / totalTime);
+    }
+
+    FrameStats FrameStatsRing::Stats(double frameBudget) const
+    {
+        FrameStats r;
+        int nbFrames = NbStoredFrames();
+        if (nbFrames <= 1)
+            return r;
+
+        int nbDurations = nbFrames - 1;
+        double sum = 0.;
+        r.minFrameTime = TimestampAt(1) - TimestampAt(0);
+        r.maxFrameTime = r.minFrameTime;
+        for (int i = 0; i < nbDurations; ++i)
+        {
+            double duration = TimestampAt(i + 1) - TimestampAt(i);
+            mSortedDurations[i] = duration;
+            sum += duration;
+            r.minFrameTime = std::min(r.minFrameTime, duration);
+            r.maxFrameTime = std::max(r.maxFrameTime, duration);
+            if (duration > frameBudget)
+                ++r.nbJankFrames;
+        }
+        r.nbFrames = nbDurations;
+        r.meanFrameTime = sum / (double)nbDurations;
+
+        std::sort(mSortedDurations, mSortedDurations + nbDurations);
+        // nearest-rank percentile
+        auto percentile = [&](double p) {
+            int rank = (int)std::ceil(p * (double)nbDurations);
+            rank = std::clamp(rank, 1, nbDurations);
+            return mSortedDurations[rank - 1];
+        };
+        r.p50FrameTime = percentile(0.50);
+        r.p95FrameTime = percentile(0.95);
+        r.p99FrameTime = percentile(0.99);
+        return r;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+
+#include <cstdint>
+
+namespace HelloImGui
+{
+    // FrameStatsRing stores the timestamps of the last frames in a preallocated ring buffer:
+    // adding a frame or computing statistics never allocates.
+    class FrameStatsRing
+    {
+    public:
+        static constexpr int Capacity = 512;
+
+        // timestamp in seconds (see Internal::ClockSeconds()). Timestamps shall be increasing.
+        void AddFrame(double timestamp);
+
+        // Mean frame rate over the last `durationForMean` seconds
+        float FrameRate(double durationForMean) const;
+
+        // Statistics on the durations of the frames stored in the ring
+        FrameStats Stats(double frameBudget) const;
+
+        uint64_t NbFramesTotal() const { return mNbFramesTotal; }
+
+    private:
+        int NbStoredFrames() const;
+        // idx=0 is the oldest stored frame
+        double TimestampAt(int idx) const;
+
+        double mTimestamps[Capacity] = {};
+        uint64_t mNbFramesTotal = 0;
+        // Scratch buffer used to compute percentiles without allocating
+        mutable double mSortedDurations[Capacity] = {};
+    };
+}
@@ -0,0 +1,274 @@
+#include "hello_imgui/internal/gui_cost_profiler.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/trace_exporter.h"
+#include "imgui.h"
+#include "hello_imgui/internal/imgui_global_context.h" // must be included before imgui_internal.h
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace HelloImGui
+{
+    namespace GuiCostProfiler
+    {
+        // Weight of the last frame in the rolling averages (about the last 20 frames)
+        constexpr double kSmoothing = 0.05;
+        // Stats of the windows which were not shown during this number of profiled frames are removed
+        constexpr uint64_t kForgetAfterFrames = 600;
+
+        // What was measured during the current frame, for one entry of `stats`
+        struct FrameAccumulator
+        {
+            double duration = 0.;
+            int nbVertices = 0;
+            uint64_t lastCallFrameIdx = 0;
+        };
+
+        struct GuiCostProfilerStatics
+        {
+            bool isActive = false;
+            bool isPanelVisible = false;
+            uint64_t frameIdx = 0;  // number of profiled frames
+
+            std::vector<GuiCostStats> stats;
+            std::vector<FrameAccumulator> accumulators;  // same size as stats
+            std::unordered_map<ImGuiID, size_t> indexByKey;
+        };
+
+        static GuiCostProfilerStatics gStatics;
+
+
+        static ImGuiID StatsKey(const char* name, GuiCostKind kind)
+        {
+            return ImHashStr(name, 0, (ImGuiID)kind);
+        }
+
+        static void RemoveForgottenStats()
+        {
+            auto isForgotten = [](const FrameAccumulator& accumulator) {
+                return gStatics.frameIdx - accumulator.lastCallFrameIdx > kForgetAfterFrames;
+            };
+            if (std::none_of(gStatics.accumulators.begin(), gStatics.accumulators.end(), isForgotten))
+                return;
+
+            size_t nbKept = 0;
+            for (size_t i = 0; i < gStatics.stats.size(); ++i)
+            {
+                if (isForgotten(gStatics.accumulators[i]))
+                    continue;
+                gStatics.stats[nbKept] = std::move(gStatics.stats[i]);
+                gStatics.accumulators[nbKept] = gStatics.accumulators[i];
+                ++nbKept;
+            }
+            gStatics.stats.resize(nbKept);
+            gStatics.accumulators.resize(nbKept);
+            gStatics.indexByKey.clear();
+            for (size_t i = 0; i < nbKept; ++i)
+                gStatics.indexByKey[StatsKey(gStatics.stats[i].name.c_str(), gStatics.stats[i].kind)] = i;
+        }
+
+
+        void BeginFrame()
+        {
+            gStatics.isActive = gStatics.isPanelVisible || TraceExporter::IsActive();
+            if (gStatics.isActive)
+                ++gStatics.frameIdx;
+        }
+
+        void EndFrame()
+        {
+            if (!gStatics.isActive)
+                return;
+            gStatics.isActive = false;
+            for (size_t i = 0; i < gStatics.stats.size(); ++i)
+            {
+                GuiCostStats& stats = gStatics.stats[i];
+                FrameAccumulator& accumulator = gStatics.accumulators[i];
+                double ms = accumulator.duration * 1000.;
+                stats.msPerFrame += kSmoothing * (ms - stats.msPerFrame);
+                stats.verticesPerFrame += kSmoothing * ((double)accumulator.nbVertices - stats.verticesPerFrame);
+                accumulator.duration = 0.;
+                accumulator.nbVertices = 0;
+            }
+            RemoveForgottenStats();
+        }
+
+        bool IsActive() { return gStatics.isActive; }
+
+        void AddCall(const char* name, GuiCostKind kind, double duration, int nbVertices)
+        {
+            if (!gStatics.isActive)
+                return;
+            ImGuiID key = StatsKey(name, kind);
+            auto it = gStatics.indexByKey.find(key);
+            size_t idx;
+            if (it == gStatics.indexByKey.end())
+            {
+                // A new entry starts its rolling averages with its first measure
+                GuiCostStats stats;
+                stats.name = name;
+                stats.kind = kind;
+                stats.msPerFrame = duration * 1000.;
+                stats.verticesPerFrame = (double)nbVertices;
+                idx = gStatics.stats.size();
+                gStatics.stats.push_back(std::move(stats));
+                gStatics.accumulators.emplace_back();
+                gStatics.indexByKey[key] = idx;
+            }
+            else
+                idx = it->second;
+
+            gStatics.stats[idx].callCount += 1;
+            FrameAccumulator& accumulator = gStatics.accumulators[idx];
+            accumulator.duration += duration;
+            accumulator.nbVertices += nbVertices;
+            accumulator.lastCallFrameIdx = gStatics.frameIdx;
+        }
+
+        const std::vector<GuiCostStats>& Stats() { return gStatics.stats; }
+
+        void Reset()
+        {
+            gStatics.stats.clear();
+            gStatics.accumulators.clear();
+            gStatics.indexByKey.clear();
+        }
+
+        void SetPanelVisible(bool visible) { gStatics.isPanelVisible = visible; }
+        bool IsPanelVisible() { return gStatics.isPanelVisible; }
+
+
+        enum TopWindowsColumn
+        {
+            TopWindowsColumn_Name,
+            TopWindowsColumn_Ms,
+            TopWindowsColumn_Vertices,
+            TopWindowsColumn_Calls,
+        };
+
+        static void SortStatsIndices(std::vector<size_t>* indices, const ImGuiTableColumnSortSpecs& sortSpec)
+        {
+            const auto& allStats = gStatics.stats;
+            bool ascending = (sortSpec.SortDirection == ImGuiSortDirection_Ascending);
+            auto fnCompare = [&](size_t a, size_t b) -> bool
+            {
+                const GuiCostStats& sa = allStats[ascending ? a : b];
+                const GuiCostStats& sb = allStats[ascending ? b : a];
+                switch ((TopWindowsColumn)sortSpec.ColumnIndex)
+                {
+                    case TopWindowsColumn_Name: return sa.name < sb.name;
+                    case TopWindowsColumn_Vertices: return sa.verticesPerFrame < sb.verticesPerFrame;
+                    case TopWindowsColumn_Calls: return sa.callCount < sb.callCount;
+                    case TopWindowsColumn_Ms:
+                    default: return sa.msPerFrame < sb.msPerFrame;
+                }
+            };
+            std::stable_sort(indices->begin(), indices->end(), fnCompare);
+        }
+
+        void ShowPanel()
+        {
+            if (!gStatics.isPanelVisible)
+                return;
+            ImGui::SetNextWindowSize(ImVec2(ImGui::GetFontSize() * 30.f, ImGui::GetFontSize() * 20.f), ImGuiCond_FirstUseEver);
+            if (!ImGui::Begin("Top windows", &gStatics.isPanelVisible))
+            {
+                ImGui::End();
+                return;
+            }
+
+            double totalMs = 0.;
+            for (const auto& stats : gStatics.stats)
+                totalMs += stats.msPerFrame;
+            ImGui::Text("Gui: %.2f ms/frame", totalMs);
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Reset"))
+                Reset();
+
+            ImGuiTableFlags tableFlags = ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg
+                                         | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_ScrollY;
+            if (ImGui::BeginTable("##TopWindows", 4, tableFlags))
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Window", ImGuiTableColumnFlags_WidthStretch, 0.f, TopWindowsColumn_Name);
+                ImGui::TableSetupColumn("ms/frame",
+                                        ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending,
+                                        0.f, TopWindowsColumn_Ms);
+                ImGui::TableSetupColumn("Vertices", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.f, TopWindowsColumn_Vertices);
+                ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.f, TopWindowsColumn_Calls);
+                ImGui::TableHeadersRow();
+
+                // The values change at each frame: the rows are sorted at each frame, not only when the specs change
+                std::vector<size_t> indices(gStatics.stats.size());
+                for (size_t i = 0; i < indices.size(); ++i)
+                    indices[i] = i;
+                ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+                if (sortSpecs != nullptr && sortSpecs->SpecsCount > 0)
+                    SortStatsIndices(&indices, sortSpecs->Specs[0]);
+
+                ImVec4 callbackColor = ImGui::GetStyle().Colors[ImGuiCol_TextDisabled];
+                for (size_t idx : indices)
+                {
+                    const GuiCostStats& stats = gStatics.stats[idx];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    if (stats.kind == GuiCostKind::Callback)
+                        ImGui::TextColored(callbackColor, "%s", stats.name.c_str());
+                    else
+                        ImGui::TextUnformatted(stats.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%7.3f", stats.msPerFrame);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%7.0f", stats.verticesPerFrame);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", (unsigned long long)stats.callCount);
+                }
+                ImGui::EndTable();
+            }
+            ImGui::End();
+        }
+    }
+
+
+    // The vertices of a window, and of its child windows
+    static int CountWindowVerticesRec(ImGuiWindow* window)
+    {
+        int nbVertices = window->DrawList->VtxBuffer.Size;
+        for (ImGuiWindow* childWindow : window->DC.ChildWindows)
+            nbVertices += CountWindowVerticesRec(childWindow);
+        return nbVertices;
+    }
+
+    GuiCostScope::GuiCostScope(const char* name, GuiCostKind kind)
+        : mKind(kind)
+    {
+        if (!GuiCostProfiler::IsActive())
+            return;
+        mName = name;
+        mWindow = ImGui::GetCurrentWindowRead();
+        if (mWindow != nullptr)
+        {
+            mVtxCountStart = mWindow->DrawList->VtxBuffer.Size;
+            mNbChildWindowsStart = mWindow->DC.ChildWindows.Size;
+        }
+        mStartTime = Internal::ClockSeconds();
+    }
+
+    GuiCostScope::~GuiCostScope()
+    {
+        if (mStartTime < 0. || !GuiCostProfiler::IsActive())
+            return;
+        double now = Internal::ClockSeconds();
+        int nbVertices = 0;
+        // The current window is the same as in the constructor, unless the Gui function has unbalanced Begin/End
+        if (mWindow != nullptr && mWindow == ImGui::GetCurrentWindowRead())
+        {
+            nbVertices = mWindow->DrawList->VtxBuffer.Size - mVtxCountStart;
+            for (int i = mNbChildWindowsStart; i < mWindow->DC.ChildWindows.Size; ++i)
+                nbVertices += CountWindowVerticesRec(mWindow->DC.ChildWindows[i]);
+        }
+        GuiCostProfiler::AddCall(mName.c_str(), mKind, now - mStartTime, nbVertices);
+        TraceExporter::AddCompleteEvent(mName.c_str(), "gui", mStartTime, now - mStartTime);
+    }
+}
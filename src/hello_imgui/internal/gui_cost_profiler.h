@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ImGuiWindow;
+
+namespace HelloImGui
+{
+    // The kind of Gui code measured by GuiCostProfiler
+    enum class GuiCostKind
+    {
+        DockableWindow,  // a DockableWindow::GuiFunction
+        Callback         // a RunnerCallbacks function (ShowGui, ShowMenus, ShowStatus, PostRenderDockableWindows)
+    };
+
+    // The rolling cost of a dockable window (or of a callback)
+    struct GuiCostStats
+    {
+        std::string name;
+        GuiCostKind kind = GuiCostKind::DockableWindow;
+        double msPerFrame = 0.;        // rolling average (frames where it was not called count as 0)
+        double verticesPerFrame = 0.;  // rolling average of the vertices it emitted
+        uint64_t callCount = 0;        // total number of calls since the stats were created
+    };
+
+    // GuiCostProfiler attributes the Gui CPU time (and the emitted vertices) to each dockable window,
+    // and to the RunnerCallbacks which draw the Gui.
+    // It is active only while its panel ("Top windows", see the View menu) is visible,
+    // or while a trace is exported (see RunnerParams.traceExportFile); otherwise GuiCostScope costs almost nothing.
+    //
+    // Usage inside AbstractRunner::RenderGui():
+    //     GuiCostProfiler::BeginFrame();
+    //     { GuiCostScope scope("[ShowGui]", GuiCostKind::Callback); params.callbacks.ShowGui(); }
+    //     ...
+    //     GuiCostProfiler::EndFrame();   // updates the rolling averages
+    namespace GuiCostProfiler
+    {
+        void BeginFrame();
+        void EndFrame();
+        bool IsActive();
+
+        // Adds a measure to the current frame (called by GuiCostScope)
+        void AddCall(const char* name, GuiCostKind kind, double duration, int nbVertices);
+
+        // Stats of the windows and callbacks measured recently (unsorted)
+        const std::vector<GuiCostStats>& Stats();
+        void Reset();
+
+        void SetPanelVisible(bool visible);
+        bool IsPanelVisible();
+        // Shows the "Top windows" panel (a sortable table of the stats), if visible
+        void ShowPanel();
+    }
+
+    // RAII measure of a Gui function: its duration, and the vertices it added to the current window
+    // (and to the child windows it created).
+    // `name` is copied (when the profiler is active), since the Gui function may change it
+    // (e.g. a dockable window which renames its label).
+    class GuiCostScope
+    {
+    public:
+        GuiCostScope(const char* name, GuiCostKind kind);
+        ~GuiCostScope();
+        GuiCostScope(const GuiCostScope&) = delete;
+        GuiCostScope& operator=(const GuiCostScope&) = delete;
+    private:
+        std::string mName;
+        GuiCostKind mKind;
+        double mStartTime = -1.;
+        ImGuiWindow* mWindow = nullptr;
+        int mVtxCountStart = 0;
+        int mNbChildWindowsStart = 0;
+    };
+}
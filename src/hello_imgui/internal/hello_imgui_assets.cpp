@@ -1,4 +1,5 @@
 #include "hello_imgui/hello_imgui_assets.h"
+#include "hello_imgui/internal/asset_prefetch.h"
 #include "imgui.h"
 
 #ifdef HELLOIMGUI_INSIDE_APPLE_BUNDLE
@@ -14,7 +15,11 @@
 #endif
 
 #include "hello_imgui/hello_imgui_error.h"
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <vector>
 #include <stdio.h>
@@ -356,14 +361,125 @@ void FreeAssetFileData(AssetFileData * assetFileData)
 // Tooling to make it possible to redirect asset loading
 //
 static LoadAssetFileDataFunc loadAssetFileDataFunc = DefaultLoadAssetFileData;
+static std::atomic<bool> isLoadAssetFileDataRedirected{false};
 AssetFileData LoadAssetFileData(const char *assetPath)
 {
+    if (auto prefetched = AssetPrefetch::Take(assetPath))
+        return *prefetched;
     AssetFileData data = loadAssetFileDataFunc(assetPath);
     return data;
 }
 void SetLoadAssetFileDataFunction(LoadAssetFileDataFunc newLoadAssetFileDataFunc)
 {
     loadAssetFileDataFunc = std::move(newLoadAssetFileDataFunc);
+    isLoadAssetFileDataRedirected = true;
+}
+
+
+namespace AssetPrefetch
+{
+    // An asset is either pending (std::nullopt, until the worker reads it), or prefetched
+    struct AssetPrefetchStatics
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::map<std::string, std::optional<AssetFileData>> assets;
+        // (assetPath, full path) in reading order: the full paths are resolved by the main thread
+        std::vector<std::pair<std::string, std::string>> pendingPaths;
+        // gOverrideAssetsFolder when the full paths were resolved
+        std::string assetsFolder;
+    };
+    static AssetPrefetchStatics gStatics;
+
+    // Reads a file given by its full path (may be called by any thread)
+    static AssetFileData ReadAssetFullPath(const std::string& assetFullPath)
+    {
+    #ifdef HELLOIMGUI_USE_SDL2
+        AssetFileData r;
+        r.data = SDL_LoadFile(assetFullPath.c_str(), &r.dataSize);
+        return r;
+    #else
+        return LoadAssetFileData_Impl(assetFullPath.c_str());
+    #endif
+    }
+
+    void MarkPending(const std::vector<std::string>& assetPaths)
+    {
+        if (isLoadAssetFileDataRedirected)
+            return;
+        std::lock_guard<std::mutex> lock(gStatics.mutex);
+        gStatics.assetsFolder = gOverrideAssetsFolder;
+        for (const auto& assetPath : assetPaths)
+        {
+            if (gStatics.assets.count(assetPath) > 0)
+                continue;
+            // Missing assets are not prefetched: LoadAssetFileData will report the error, as usual
+            std::string assetFullPath = AssetFileFullPath(assetPath, false);
+            if (assetFullPath.empty())
+                continue;
+            gStatics.assets[assetPath] = std::nullopt;
+            gStatics.pendingPaths.push_back({assetPath, assetFullPath});
+        }
+    }
+
+    void LoadPending()
+    {
+        std::vector<std::pair<std::string, std::string>> pendingPaths;
+        {
+            std::lock_guard<std::mutex> lock(gStatics.mutex);
+            pendingPaths.swap(gStatics.pendingPaths);
+        }
+        for (const auto& [assetPath, assetFullPath] : pendingPaths)
+        {
+            AssetFileData data = ReadAssetFullPath(assetFullPath);
+
+            std::lock_guard<std::mutex> lock(gStatics.mutex);
+            auto it = gStatics.assets.find(assetPath);
+            if (data.data != nullptr && it != gStatics.assets.end())
+                it->second = data;
+            else
+            {
+                if (data.data != nullptr)
+                    FreeAssetFileData(&data);
+                if (it != gStatics.assets.end())
+                    gStatics.assets.erase(it);
+            }
+            gStatics.condition.notify_all();
+        }
+    }
+
+    std::optional<AssetFileData> Take(const std::string& assetPath)
+    {
+        std::unique_lock<std::mutex> lock(gStatics.mutex);
+        if (gStatics.assets.empty() || isLoadAssetFileDataRedirected)
+            return std::nullopt;
+        // The assets folder was changed after the prefetch started (e.g. by SetAssetsFolder() in PostInit):
+        // the prefetched files may come from the previous folder (they are freed by Clear())
+        if (gStatics.assetsFolder != gOverrideAssetsFolder)
+            return std::nullopt;
+        auto isPending = [&assetPath]() {
+            auto it = gStatics.assets.find(assetPath);
+            return it != gStatics.assets.end() && !it->second.has_value();
+        };
+        gStatics.condition.wait(lock, [&isPending]() { return !isPending(); });
+
+        auto it = gStatics.assets.find(assetPath);
+        if (it == gStatics.assets.end())
+            return std::nullopt;
+        std::optional<AssetFileData> r = it->second;
+        gStatics.assets.erase(it);
+        return r;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(gStatics.mutex);
+        for (auto& [assetPath, data] : gStatics.assets)
+            if (data.has_value())
+                FreeAssetFileData(&data.value());
+        gStatics.assets.clear();
+        gStatics.pendingPaths.clear();
+    }
 }
 
 
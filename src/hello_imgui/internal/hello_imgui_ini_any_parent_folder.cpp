@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <filesystem>
+#include <mutex>
 #include <string>
 #include <optional>
 
@@ -41,20 +42,54 @@ namespace HelloImGui
             return allIniFileToSearch;
         };
 
-        template<typename T>
-        std::optional<T> _readIniValue(const std::string& iniFilePath, const std::string& sectionName, const std::string& valueName)
+        //
+        // The hello_imgui.ini files are parsed once (for a given current folder), since they are read
+        // several times during startup (OpenGL options, DPI params), possibly by a prefetch thread.
+        // Note: they are not read again if they are modified while the application is running.
+        //
+        struct ParentFoldersIniCache
         {
-            if (! std::filesystem::exists(iniFilePath))
-                return std::nullopt;
-            if (! std::filesystem::is_regular_file(iniFilePath))
-                return std::nullopt;
+            std::mutex mutex;
+            bool isLoaded = false;
+            std::string currentFolder;
+            std::vector<ini::IniFile> iniFiles; // from the current folder to the root
+        };
+        static ParentFoldersIniCache gCache;
 
-            try
+        // Shall be called with gCache.mutex locked
+        static void _loadIniFilesIfNeeded()
+        {
+            std::string currentFolder = std::filesystem::current_path().string();
+            if (gCache.isLoaded && gCache.currentFolder == currentFolder)
+                return;
+
+            gCache.iniFiles.clear();
+            for (const auto& iniFilePath: _allHelloImGuiIniFilesToSearch())
             {
+                if (! std::filesystem::exists(iniFilePath))
+                    continue;
+                if (! std::filesystem::is_regular_file(iniFilePath))
+                    continue;
+                try
+                {
+                    ini::IniFile ini;
+                    ini.load(iniFilePath);
+                    gCache.iniFiles.push_back(std::move(ini));
+                }
+                catch(...)
+                {
+                }
+            }
+            gCache.currentFolder = currentFolder;
+            gCache.isLoaded = true;
+        }
 
+        template<typename T>
+        std::optional<T> _readIniValue(ini::IniFile& ini, const std::string& sectionName, const std::string& valueName)
+        {
+            try
+            {
                 std::optional<T> result = std::nullopt;
-                ini::IniFile ini;
-                ini.load(iniFilePath);
                 if (ini.find(sectionName) != ini.end())
                 {
                     auto& section = ini.at(sectionName);
@@ -72,9 +107,11 @@ namespace HelloImGui
         template <typename T>
         std::optional<T> _readIniValueInParentFolders(const std::string& sectionName, const std::string& valueName)
         {
-            for (const auto& iniFile: _allHelloImGuiIniFilesToSearch())
+            std::lock_guard<std::mutex> lock(gCache.mutex);
+            _loadIniFilesIfNeeded();
+            for (auto& ini: gCache.iniFiles)
             {
-                auto value = _readIniValue<T>(iniFile, sectionName, valueName);
+                auto value = _readIniValue<T>(ini, sectionName, valueName);
                 if (value.has_value())
                     return value;
             }
@@ -82,6 +119,12 @@ namespace HelloImGui
         };
 
 
+        void prefetchIniFiles()
+        {
+            std::lock_guard<std::mutex> lock(gCache.mutex);
+            _loadIniFilesIfNeeded();
+        }
+
         std::optional<float> readFloatValue(const std::string& sectionName, const std::string& valueName)
         {
             return _readIniValueInParentFolders<float>(sectionName, valueName);
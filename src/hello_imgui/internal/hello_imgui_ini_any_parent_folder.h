@@ -11,5 +11,8 @@ namespace HelloImGui
         std::optional<bool> readBoolValue(const std::string &sectionName, const std::string &valueName);
         std::optional<std::string> readStringValue(const std::string &sectionName, const std::string &valueName);
         std::optional<int> readIntValue(const std::string &sectionName, const std::string &valueName);
+
+        // Reads and parses the hello_imgui.ini files now (they are read once, and cached). Thread safe.
+        void prefetchIniFiles();
     }
 }
\ No newline at end of file
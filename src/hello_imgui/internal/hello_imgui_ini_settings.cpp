@@ -3,8 +3,18 @@
 #include "hello_imgui/internal/functional_utils.h"
 #include "imgui_internal.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
+#ifndef __EMSCRIPTEN__
+#include <condition_variable>
+#include <thread>
+#endif
 
 #include <nlohmann/json.hpp>
 
@@ -180,14 +190,178 @@ namespace HelloImGui
 
         void IniParts::WriteToFile(const std::string& iniPartsFilename)
         {
+            // Write to a temporary file, then rename it: the settings file is never left half written
             std::string iniPartsContent = JoinIniParts(*this);
-            FunctionalUtils::write_text_file(iniPartsFilename, iniPartsContent);
+            std::string tempFilename = iniPartsFilename + ".tmp";
+            {
+                std::ofstream stream(tempFilename, std::ios::binary);
+                if (!stream.good())
+                    return;
+                stream << iniPartsContent;
+                if (!stream.good())
+                    return;
+            }
+            std::error_code ec;
+            std::filesystem::rename(tempFilename, iniPartsFilename, ec);
+            if (ec)
+                std::filesystem::remove(tempFilename, ec);
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // IniParts cache
+        // ---------------------------------------------------------------------------------------------
+        namespace IniPartsCache
+        {
+            struct CachedFile
+            {
+                IniParts iniParts;
+                uint64_t version = 0;         // incremented by each Store
+                uint64_t writtenVersion = 0;  // version which was written to the disk
+            };
+
+            static std::mutex gMutex;            // protects gFiles & the writer thread state
+            static std::mutex gWriteFileMutex;   // serializes the writes to the disk
+            static std::map<std::string, CachedFile> gFiles;
+
+            // Delay after a Store, during which other Stores are coalesced into the same write
+            static constexpr auto gCoalesceDelay = std::chrono::milliseconds(500);
+
+            static void WriteDirtyFiles()
+            {
+                std::lock_guard<std::mutex> writeLock(gWriteFileMutex);
+
+                std::vector<std::pair<std::string, CachedFile>> dirtyFiles;
+                {
+                    std::lock_guard<std::mutex> lock(gMutex);
+                    for (const auto& [filename, cachedFile]: gFiles)
+                        if (cachedFile.version != cachedFile.writtenVersion)
+                            dirtyFiles.emplace_back(filename, cachedFile);
+                }
+
+                for (auto& [filename, cachedFile]: dirtyFiles)
+                    cachedFile.iniParts.WriteToFile(filename);
+
+                {
+                    std::lock_guard<std::mutex> lock(gMutex);
+                    for (const auto& [filename, cachedFile]: dirtyFiles)
+                    {
+                        auto it = gFiles.find(filename);
+                        if (it != gFiles.end())
+                            it->second.writtenVersion = std::max(it->second.writtenVersion, cachedFile.version);
+                    }
+                }
+            }
+
+#ifndef __EMSCRIPTEN__
+            static std::condition_variable gCondition;
+            static std::thread gWriterThread;
+            static bool gStopRequested = false;
+            static bool gHasPendingStore = false;
+
+            static void WriterThreadLoop()
+            {
+                std::unique_lock<std::mutex> lock(gMutex);
+                while (true)
+                {
+                    gCondition.wait(lock, [] { return gStopRequested || gHasPendingStore; });
+                    if (gStopRequested)
+                        return;
+                    // Wait a bit, so that the next Stores are written together
+                    gCondition.wait_for(lock, gCoalesceDelay, [] { return gStopRequested; });
+                    if (gStopRequested)
+                        return;
+                    gHasPendingStore = false;
+
+                    lock.unlock();
+                    WriteDirtyFiles();
+                    lock.lock();
+                }
+            }
+
+            static void StopWriterThread()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(gMutex);
+                    if (!gWriterThread.joinable())
+                        return;
+                    gStopRequested = true;
+                }
+                gCondition.notify_all();
+                gWriterThread.join();
+                std::lock_guard<std::mutex> lock(gMutex);
+                gStopRequested = false;
+                gHasPendingStore = false;
+            }
+
+            // Flushes the pending writes, when the program exits without calling FlushIniPartsCache()
+            struct FlushAtExit
+            {
+                ~FlushAtExit() { FlushIniPartsCache(); }
+            };
+            static FlushAtExit gFlushAtExit;
+#endif
+        }
+
+        IniParts LoadIniPartsCached(const std::string& iniPartsFilename)
+        {
+            {
+                std::lock_guard<std::mutex> lock(IniPartsCache::gMutex);
+                auto it = IniPartsCache::gFiles.find(iniPartsFilename);
+                if (it != IniPartsCache::gFiles.end())
+                    return it->second.iniParts;
+            }
+
+            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            std::lock_guard<std::mutex> lock(IniPartsCache::gMutex);
+            // (another thread may have loaded or stored this file in the meantime)
+            auto [it, inserted] = IniPartsCache::gFiles.try_emplace(iniPartsFilename);
+            if (inserted)
+                it->second.iniParts = iniParts;
+            return it->second.iniParts;
+        }
+
+        void StoreIniPartsCached(const std::string& iniPartsFilename, const IniParts& iniParts)
+        {
+            {
+                std::lock_guard<std::mutex> lock(IniPartsCache::gMutex);
+                auto& cachedFile = IniPartsCache::gFiles[iniPartsFilename];
+                cachedFile.iniParts = iniParts;
+                ++cachedFile.version;
+#ifndef __EMSCRIPTEN__
+                IniPartsCache::gHasPendingStore = true;
+                if (!IniPartsCache::gWriterThread.joinable())
+                    IniPartsCache::gWriterThread = std::thread(IniPartsCache::WriterThreadLoop);
+#endif
+            }
+#ifndef __EMSCRIPTEN__
+            IniPartsCache::gCondition.notify_all();
+#else
+            // No background thread: write now
+            IniPartsCache::WriteDirtyFiles();
+#endif
+        }
+
+        void FlushIniPartsCache()
+        {
+#ifndef __EMSCRIPTEN__
+            IniPartsCache::StopWriterThread();
+#endif
+            IniPartsCache::WriteDirtyFiles();
+        }
+
+        void ForgetIniPartsCache(const std::string& iniPartsFilename)
+        {
+            // Pending writes of this file are dropped
+            std::lock_guard<std::mutex> writeLock(IniPartsCache::gWriteFileMutex);
+            std::lock_guard<std::mutex> lock(IniPartsCache::gMutex);
+            IniPartsCache::gFiles.erase(iniPartsFilename);
         }
 
         void SaveLastRunWindowBounds(const std::string& iniPartsFilename, const ScreenBounds& windowBounds)
         {
             auto& dpiAwareParams = HelloImGui::GetRunnerParams()->dpiAwareParams;
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
 
             ini::IniFile iniFile;
             iniFile["AppWindow"]["WindowPosition"] = IntPairToString(windowBounds.position);
@@ -196,12 +370,12 @@ namespace HelloImGui
             std::string iniContent = iniFile.encode();
 
             iniParts.SetIniPart("AppWindow", iniContent);
-            iniParts.WriteToFile(iniPartsFilename);
+            StoreIniPartsCached(iniPartsFilename, iniParts);
         }
 
         std::optional<ScreenBounds> LoadLastRunWindowBounds(const std::string& iniPartsFilename)
         {
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
 
             if (!iniParts.HasIniPart("AppWindow"))
                 return std::nullopt;
@@ -255,7 +429,7 @@ namespace HelloImGui
 
         std::optional<float> LoadLastRunDpiWindowSizeFactor(const std::string& iniPartsFilename)
         {
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
 
             if (!iniParts.HasIniPart("AppWindow"))
                 return std::nullopt;
@@ -296,7 +470,7 @@ namespace HelloImGui
             return;
             std::string iniPartName = "ImGui_" + details::SanitizeIniNameOrCategory(layoutName);
 
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             if (!iniParts.HasIniPart(iniPartName))
                 return;
             auto imguiSettingsContent = iniParts.GetIniPart(iniPartName);
@@ -310,16 +484,16 @@ namespace HelloImGui
 
             std::string imguiSettingsContent = ImGui::SaveIniSettingsToMemory();
 
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             iniParts.SetIniPart(iniPartName, imguiSettingsContent);
-            iniParts.WriteToFile(iniPartsFilename);
+            StoreIniPartsCached(iniPartsFilename, iniParts);
         }
 
         bool HasUserDockingSettingsInImguiSettings(const std::string& iniPartsFilename, const DockingParams& dockingParams)
         {
             std::string iniPartName = "ImGui_" + details::SanitizeIniNameOrCategory(dockingParams.layoutName);
 
-            auto iniParts = HelloImGuiIniSettings::IniParts::LoadFromFile(iniPartsFilename);
+            auto iniParts = LoadIniPartsCached(iniPartsFilename);
             if (!iniParts.HasIniPart(iniPartName))
                 return false;
 
@@ -371,9 +545,9 @@ namespace HelloImGui
             ini::IniFile iniFile;
             SaveDockableWindowsVisibilityRec(iniFile, dockingParams.dockableWindows);
 
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             iniParts.SetIniPart(iniPartName, iniFile.encode());
-            iniParts.WriteToFile(iniPartsFilename);
+            StoreIniPartsCached(iniPartsFilename, iniParts);
         }
 
         void LoadDockableWindowsVisibilityRec(ini::IniFile& iniFile,
@@ -403,7 +577,7 @@ namespace HelloImGui
             std::string iniPartName =
                 "Layout_" + details::SanitizeIniNameOrCategory(inOutDockingParams->layoutName);
 
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             if (!iniParts.HasIniPart(iniPartName))
                 return;
 
@@ -441,7 +615,7 @@ namespace HelloImGui
             std::string layoutName = "";
             std::string themeName = "";
             {
-                IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+                IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
                 if (iniParts.HasIniPart(iniPartName))
                 {
                     ini::IniFile iniFile;
@@ -510,9 +684,9 @@ namespace HelloImGui
                 iniFile["Idling"]["EnableIdling"] = runnerParams.fpsIdling.enableIdling;
             }
 
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             iniParts.SetIniPart(iniPartName, iniFile.encode());
-            iniParts.WriteToFile(iniPartsFilename);
+            StoreIniPartsCached(iniPartsFilename, iniParts);
 
             SaveSplitIds(iniPartsFilename);
         }
@@ -521,15 +695,15 @@ namespace HelloImGui
         void  SaveUserPref(const std::string& iniPartsFilename, const std::string& userPrefName, const std::string& userPrefContent)
         {
             return;
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             iniParts.SetIniPart(userPrefName, userPrefContent + "\n");
-            iniParts.WriteToFile(iniPartsFilename);
+            StoreIniPartsCached(iniPartsFilename, iniParts);
         }
 
         std::string LoadUserPref(const std::string& iniPartsFilename, const std::string& userPrefName)
         {
             return "";
-            IniParts iniParts = IniParts::LoadFromFile(iniPartsFilename);
+            IniParts iniParts = LoadIniPartsCached(iniPartsFilename);
             if (iniParts.HasIniPart(userPrefName))
             {
                 std::string contentWithNewLine = iniParts.GetIniPart(userPrefName);
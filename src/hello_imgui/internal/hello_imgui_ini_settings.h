@@ -56,6 +56,18 @@ namespace HelloImGui
         IniParts SplitIniParts(const std::string& s);
         std::string JoinIniParts(const IniParts& parts);
 
+        //
+        // IniParts files are cached in memory: each file is read once, and the modifications are written
+        // by a background thread, shortly after the last one (so that successive writes are coalesced).
+        // Files are written atomically (to a temporary file, which is then renamed).
+        //
+        IniParts LoadIniPartsCached(const std::string& iniPartsFilename);
+        void     StoreIniPartsCached(const std::string& iniPartsFilename, const IniParts& iniParts);
+        // Writes the pending modifications now (called by the runner at exit)
+        void     FlushIniPartsCache();
+        // Drops the cached content of a file (when it is deleted)
+        void     ForgetIniPartsCache(const std::string& iniPartsFilename);
+
         //
         // The settings below are global to the app
         //
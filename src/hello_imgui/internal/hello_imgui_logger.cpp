@@ -1,7 +1,15 @@
 #include "hello_imgui/hello_imgui_logger.h"
 #include "hello_imgui/internal/imguial_term.h"
 #include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/log_file_sink.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace HelloImGui
 {
@@ -11,42 +19,346 @@ namespace InternalLogBuffer
     static constexpr size_t gMaxBufferSize = 600000;
     char gLogBuffer_[gMaxBufferSize];
     ImGuiAl::Log gLog(gLogBuffer_, gMaxBufferSize);
-    std::mutex gLogMutex;
+    std::mutex gLogMutex; // protects gLog and gLogFileSink (i.e. the consumer side)
+    LogFileSink gLogFileSink;
+}
+
+
+// Producers (any thread) never touch gLog: they format their message, and push it into a staging ring
+// which is owned by their thread (a lock-free single-producer / single-consumer queue).
+// The staged records are drained into gLog by the UI thread, once per frame and inside LogGui().
+namespace LogStaging
+{
+    struct Record
+    {
+        uint64_t sequence = 0; // global order of the records, across threads
+        LogRecord logRecord;
+    };
+
+    static constexpr uint64_t gRingCapacity = 1024;
+
+    struct ThreadStaging
+    {
+        Record ring[gRingCapacity];
+        std::atomic<uint64_t> head{0};      // next record to drain (written by the consumer)
+        std::atomic<uint64_t> tail{0};      // next free slot (written by the producer)
+        std::atomic<bool> isOwned{true};    // a staging is reused by a new thread once its owner thread exited
+        // Once its ring was full, a thread keeps using gOverflowRecords until the next drain,
+        // so that its records are never reordered (modified under gOverflowMutex)
+        std::atomic<bool> hasOverflowed{false};
+        ThreadStaging* next = nullptr;      // immutable once the staging is published in gStagings
+    };
+
+    // Lock-free list of the stagings (they are never freed, and are reused by new threads)
+    static std::atomic<ThreadStaging*> gStagings{nullptr};
+    static std::atomic<uint64_t> gNextSequence{0};
+    static std::atomic<unsigned> gNextThreadId{1};
+
+    // Used only when the ring of a thread is full (i.e. it logs faster than the UI thread drains).
+    // It is bounded as well (e.g. if no frame is rendered while threads log): the newest records are then dropped
+    static constexpr size_t gOverflowCapacity = 64 * 1024;
+    static std::mutex gOverflowMutex;
+    static std::vector<Record> gOverflowRecords;
+    static size_t gNbDroppedRecords = 0;  // since the last drain
+
+    static ThreadStaging* AcquireStaging()
+    {
+        for (ThreadStaging* staging = gStagings.load(std::memory_order_acquire); staging != nullptr; staging = staging->next)
+        {
+            bool expected = false;
+            if (staging->isOwned.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                return staging;
+        }
+
+        auto* staging = new ThreadStaging();
+        ThreadStaging* head = gStagings.load(std::memory_order_relaxed);
+        do
+        {
+            staging->next = head;
+        } while (!gStagings.compare_exchange_weak(head, staging, std::memory_order_release, std::memory_order_relaxed));
+        return staging;
+    }
+
+    struct ThreadStagingOwner
+    {
+        ThreadStaging* staging = AcquireStaging();
+        ~ThreadStagingOwner() { staging->isOwned.store(false, std::memory_order_release); }
+    };
+
+    static ThreadStaging& CurrentThreadStaging()
+    {
+        thread_local ThreadStagingOwner owner;
+        return *owner.staging;
+    }
+
+    static unsigned CurrentThreadId()
+    {
+        thread_local unsigned threadId = gNextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return threadId;
+    }
+
+    static void Push(LogLevel level, std::string&& text)
+    {
+        Record record;
+        record.sequence = gNextSequence.fetch_add(1, std::memory_order_relaxed);
+        record.logRecord.level = level;
+        record.logRecord.timestamp = Internal::ClockSeconds();
+        record.logRecord.threadId = CurrentThreadId();
+        record.logRecord.message = std::move(text);
 
+        ThreadStaging& staging = CurrentThreadStaging();
+        uint64_t tail = staging.tail.load(std::memory_order_relaxed);
+        bool canUseRing = !staging.hasOverflowed.load(std::memory_order_relaxed)
+            && (tail - staging.head.load(std::memory_order_acquire) < gRingCapacity);
+        if (canUseRing)
+        {
+            staging.ring[tail % gRingCapacity] = std::move(record);
+            staging.tail.store(tail + 1, std::memory_order_release);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(gOverflowMutex);
+            staging.hasOverflowed.store(true, std::memory_order_relaxed);
+            if (gOverflowRecords.size() < gOverflowCapacity)
+                gOverflowRecords.push_back(std::move(record));
+            else
+                ++gNbDroppedRecords;
+        }
+    }
+
+    // Shall be called with gLogMutex locked (single consumer)
+    static void DrainInto(ImGuiAl::Log& log, LogFileSink& fileSink)
+    {
+        std::vector<Record> records;
+        size_t nbDroppedRecords = 0;
+        {
+            // The overflow records are taken first: the ring records which precede them are then
+            // guaranteed to be read in the same drain
+            std::lock_guard<std::mutex> lock(gOverflowMutex);
+            std::move(gOverflowRecords.begin(), gOverflowRecords.end(), std::back_inserter(records));
+            gOverflowRecords.clear();
+            nbDroppedRecords = gNbDroppedRecords;
+            gNbDroppedRecords = 0;
+
+            for (ThreadStaging* staging = gStagings.load(std::memory_order_acquire); staging != nullptr; staging = staging->next)
+            {
+                uint64_t head = staging->head.load(std::memory_order_relaxed);
+                uint64_t tail = staging->tail.load(std::memory_order_acquire);
+                for (uint64_t i = head; i < tail; ++i)
+                    records.push_back(std::move(staging->ring[i % gRingCapacity]));
+                staging->head.store(tail, std::memory_order_release);
+                staging->hasOverflowed.store(false, std::memory_order_relaxed);
+            }
+        }
+        if (nbDroppedRecords > 0)
+        {
+            Record warning;
+            warning.sequence = gNextSequence.fetch_add(1, std::memory_order_relaxed);
+            warning.logRecord.level = LogLevel::Warning;
+            warning.logRecord.timestamp = Internal::ClockSeconds();
+            warning.logRecord.threadId = CurrentThreadId();
+            warning.logRecord.message = std::to_string(nbDroppedRecords) + " log records were dropped (they were logged faster than the log was displayed)";
+            records.push_back(std::move(warning));
+        }
+        if (records.empty())
+            return;
+
+        std::sort(records.begin(), records.end(),
+                  [](const Record& a, const Record& b) { return a.sequence < b.sequence; });
+        for (const auto& record: records)
+        {
+            const LogRecord& logRecord = record.logRecord;
+            fileSink.Append(logRecord);
+
+            log.setTimestamp(logRecord.timestamp);
+            log.setThreadId(logRecord.threadId);
+            if (logRecord.level == LogLevel::Debug)
+                log.debug("%s", logRecord.message.c_str());
+            else if (logRecord.level == LogLevel::Info)
+                log.info("%s", logRecord.message.c_str());
+            else if (logRecord.level == LogLevel::Warning)
+                log.warning("%s", logRecord.message.c_str());
+            else
+                log.error("%s", logRecord.message.c_str());
+        }
+    }
+
+    static std::string FormatV(char const* const format, va_list args)
+    {
+        va_list args_copy;
+        va_copy(args_copy, args);
+        char buffer[256];
+        int needed = vsnprintf(buffer, sizeof(buffer), format, args);
+        std::string r;
+        if (needed < 0)
+            r = format;
+        else if ((size_t)needed < sizeof(buffer))
+            r.assign(buffer, (size_t)needed);
+        else
+        {
+            r.resize((size_t)needed + 1);
+            vsnprintf(&r[0], r.size(), format, args_copy);
+            r.resize((size_t)needed);
+        }
+        va_end(args_copy);
+        return r;
+    }
 }
 
+
 void Log(LogLevel level, char const* const format, ...)
 {
-    std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
-    
-    va_list args;
-    va_start(args, format);
-
-    if (level == LogLevel::Debug)
-        InternalLogBuffer::gLog.debug(format, args);
-    else if (level == LogLevel::Info)
-        InternalLogBuffer::gLog.info(format, args);
-    else if (level == LogLevel::Warning)
-        InternalLogBuffer::gLog.warning(format, args);
-    else if (level == LogLevel::Error)
-        InternalLogBuffer::gLog.error(format, args);
-    else
+    if (level != LogLevel::Debug && level != LogLevel::Info && level != LogLevel::Warning && level != LogLevel::Error)
         throw std::runtime_error("Log: bad LogLevel !");
 
+    va_list args;
+    va_start(args, format);
+    std::string text = LogStaging::FormatV(format, args);
     va_end(args);
+
+    LogStaging::Push(level, std::move(text));
 }
 
 void LogClear()
 {
     std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+    LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
     InternalLogBuffer::gLog.clear();
 }
 
+// When a file sink is open, LogGui can display the history, page by page
+namespace LogHistoryGui
+{
+    static constexpr size_t gPageSize = 1000;
+    static bool gShowHistory = false;
+    static size_t gPageIndex = 0;
+    static std::vector<LogRecord> gPageRecords;
+    static bool gIsPageLoaded = false;
+
+    static ImVec4 LevelColor(LogLevel level)
+    {
+        if (level == LogLevel::Error)
+            return ImVec4(1.f, 0.4f, 0.4f, 1.f);
+        if (level == LogLevel::Warning)
+            return ImVec4(1.f, 1.f, 0.4f, 1.f);
+        if (level == LogLevel::Info)
+            return ImVec4(0.4f, 1.f, 0.4f, 1.f);
+        return ImGui::GetStyle().Colors[ImGuiCol_TextDisabled];
+    }
+
+    // Shall be called with gLogMutex locked
+    static void Gui(LogFileSink& fileSink, ImVec2 size)
+    {
+        size_t nbRecords = fileSink.NbRecords();
+        size_t nbPages = std::max<size_t>((nbRecords + gPageSize - 1) / gPageSize, 1);
+        if (gPageIndex >= nbPages)
+        {
+            gPageIndex = nbPages - 1;
+            gIsPageLoaded = false;
+        }
+
+        ImGui::BeginDisabled(gPageIndex + 1 >= nbPages);
+        if (ImGui::Button("<< Older##LogHistory"))
+        {
+            ++gPageIndex;
+            gIsPageLoaded = false;
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        ImGui::BeginDisabled(gPageIndex == 0);
+        if (ImGui::Button("Newer >>##LogHistory"))
+        {
+            --gPageIndex;
+            gIsPageLoaded = false;
+        }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        if (ImGui::Button("Refresh##LogHistory"))
+            gIsPageLoaded = false;
+        ImGui::SameLine();
+        ImGui::Text("Page %zu / %zu (%zu records)", nbPages - gPageIndex, nbPages, nbRecords);
+
+        // Pages are only read from the disk when needed
+        if (!gIsPageLoaded)
+        {
+            gPageRecords = fileSink.ReadPage(gPageIndex, gPageSize);
+            gIsPageLoaded = true;
+        }
+
+        ImGui::BeginChild("##LogHistoryRecords", size, false, ImGuiWindowFlags_HorizontalScrollbar);
+        ImGuiListClipper clipper;
+        clipper.Begin((int)gPageRecords.size());
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+            {
+                const LogRecord& record = gPageRecords[(size_t)i];
+                ImGui::TextDisabled("%10.3f T%-3u ", record.timestamp, record.threadId);
+                ImGui::SameLine(0.f, 0.f);
+                ImGui::PushStyleColor(ImGuiCol_Text, LevelColor(record.level));
+                ImGui::TextUnformatted(record.message.c_str(), record.message.c_str() + record.message.size());
+                ImGui::PopStyleColor();
+            }
+        }
+        clipper.End();
+        ImGui::EndChild();
+    }
+}
+
 void LogGui(ImVec2 size, bool minimal)
 {
     std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+    LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
+
+    if (!minimal && InternalLogBuffer::gLogFileSink.IsOpen())
+    {
+        if (ImGui::Checkbox("History (from disk)##LogHistory", &LogHistoryGui::gShowHistory))
+            LogHistoryGui::gIsPageLoaded = false;
+        if (LogHistoryGui::gShowHistory)
+        {
+            LogHistoryGui::Gui(InternalLogBuffer::gLogFileSink, size);
+            return;
+        }
+    }
     InternalLogBuffer::gLog.draw(size, minimal);
 }
 
-}  // namespace HelloImGui
+bool LogOpenFileSink(const LogFileSinkParams& params)
+{
+    std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+    // Records logged before the sink is opened are not written to it
+    LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
+    return InternalLogBuffer::gLogFileSink.Open(params);
+}
+
+void LogCloseFileSink()
+{
+    std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+    LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
+    InternalLogBuffer::gLogFileSink.Close();
+}
+
+size_t LogFileSinkNbRecords()
+{
+    std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+    LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
+    return InternalLogBuffer::gLogFileSink.NbRecords();
+}
+
+std::vector<LogRecord> LogFileSinkReadPage(size_t pageIndex, size_t pageSize)
+{
+    std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+    LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
+    return InternalLogBuffer::gLogFileSink.ReadPage(pageIndex, pageSize);
+}
 
+namespace internal
+{
+    void DrainStagedLogRecords()
+    {
+        std::lock_guard<std::mutex> lock(InternalLogBuffer::gLogMutex);
+        LogStaging::DrainInto(InternalLogBuffer::gLog, InternalLogBuffer::gLogFileSink);
+    }
+}
+
+}  // namespace HelloImGui
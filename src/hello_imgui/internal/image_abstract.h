@@ -11,6 +11,10 @@ namespace HelloImGui
     public:
          int Width = 0;
          int Height = 0;
+         // UV sub-rectangle of the image inside its texture
+         // (differs from (0,0)-(1,1) when the image is stored in an atlas page)
+         ImVec2 TextureUv0 = ImVec2(0.f, 0.f);
+         ImVec2 TextureUv1 = ImVec2(1.f, 1.f);
          virtual ImTextureID TextureID() = 0;
 
         ImageAbstract() = default;
@@ -0,0 +1,182 @@
+#include "image_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace HelloImGui
+{
+    // Each image is surrounded by a 1 pixel gutter (a copy of its border pixels),
+    // so that linear filtering does not bleed neighbour images
+    static constexpr int kGutter = 1;
+
+    struct ImageAtlasShelf
+    {
+        int y = 0;
+        int height = 0;
+        int xCursor = 0;
+    };
+
+    struct ImageAtlasPage
+    {
+        int pageSize = 0;
+        std::vector<unsigned char> pixels; // RGBA, pageSize * pageSize
+        std::vector<ImageAtlasShelf> shelves;
+        int shelvesBottom = 0;
+
+        std::function<ImageAbstractPtr()> createPageTexture;
+        ImageAbstractPtr texture;
+        bool isDirty = true;
+        std::shared_ptr<std::vector<ImageAbstractPtr>> retiredTextures;
+
+        // Shelf packing: returns false if there is no room left for a (w, h) rectangle
+        bool Allocate(int w, int h, int* outX, int* outY)
+        {
+            for (auto& shelf: shelves)
+            {
+                // Do not waste a tall shelf for a much smaller image
+                bool isShelfAdequate = (h <= shelf.height) && (h * 2 >= shelf.height);
+                if (isShelfAdequate && shelf.xCursor + w <= pageSize)
+                {
+                    *outX = shelf.xCursor;
+                    *outY = shelf.y;
+                    shelf.xCursor += w;
+                    return true;
+                }
+            }
+            if (shelvesBottom + h > pageSize || w > pageSize)
+                return false;
+            ImageAtlasShelf shelf;
+            shelf.y = shelvesBottom;
+            shelf.height = h;
+            shelf.xCursor = w;
+            shelves.push_back(shelf);
+            shelvesBottom += h;
+            *outX = 0;
+            *outY = shelf.y;
+            return true;
+        }
+
+        // Copies the image at (x, y), and extrudes its border pixels into the gutter around it
+        void Blit(int x, int y, int width, int height, const unsigned char* image_data_rgba)
+        {
+            for (int dy = -kGutter; dy < height + kGutter; ++dy)
+            {
+                int srcY = std::clamp(dy, 0, height - 1);
+                for (int dx = -kGutter; dx < width + kGutter; ++dx)
+                {
+                    int srcX = std::clamp(dx, 0, width - 1);
+                    const unsigned char* src = image_data_rgba + ((size_t)srcY * width + srcX) * 4;
+                    unsigned char* dst = pixels.data() + ((size_t)(y + dy) * pageSize + (x + dx)) * 4;
+                    std::memcpy(dst, src, 4);
+                }
+            }
+            isDirty = true;
+        }
+
+        ImTextureID TextureID()
+        {
+            if (isDirty)
+            {
+                if (texture)
+                    retiredTextures->push_back(texture);
+                texture = createPageTexture();
+                texture->_impl_StoreTexture(pageSize, pageSize, pixels.data());
+                isDirty = false;
+            }
+            return texture->TextureID();
+        }
+    };
+
+    // An image stored inside an atlas page
+    struct ImageAtlasRegion: public ImageAbstract
+    {
+        std::shared_ptr<ImageAtlasPage> page;
+        int x = 0, y = 0;
+
+        ImTextureID TextureID() override
+        {
+            return page->TextureID();
+        }
+
+        void _impl_StoreTexture(int width, int height, unsigned char* image_data_rgba) override
+        {
+            IM_ASSERT(width == Width && height == Height);
+            page->Blit(x, y, width, height, image_data_rgba);
+        }
+    };
+
+
+    ImageAtlas::ImageAtlas(std::function<ImageAbstractPtr()> createPageTexture, int pageSize)
+        : mCreatePageTexture(std::move(createPageTexture))
+        , mPageSize(pageSize)
+        , mRetiredTextures(std::make_shared<std::vector<ImageAbstractPtr>>())
+    {
+    }
+
+    ImageAtlas::~ImageAtlas() = default;
+
+    ImageAbstractPtr ImageAtlas::AddImage(int width, int height, const unsigned char* image_data_rgba)
+    {
+        int paddedWidth = width + 2 * kGutter, paddedHeight = height + 2 * kGutter;
+        if (paddedWidth > mPageSize || paddedHeight > mPageSize)
+            return nullptr;
+
+        mPages.erase(
+            std::remove_if(mPages.begin(), mPages.end(), [](const auto& page) { return page.expired(); }),
+            mPages.end());
+
+        std::shared_ptr<ImageAtlasPage> page;
+        int x = 0, y = 0;
+        for (auto& weakPage: mPages)
+        {
+            auto candidate = weakPage.lock();
+            if (candidate && candidate->Allocate(paddedWidth, paddedHeight, &x, &y))
+            {
+                page = candidate;
+                break;
+            }
+        }
+        if (!page)
+        {
+            page = std::make_shared<ImageAtlasPage>();
+            page->pageSize = mPageSize;
+            page->pixels.resize((size_t)mPageSize * (size_t)mPageSize * 4, 0);
+            page->createPageTexture = mCreatePageTexture;
+            page->retiredTextures = mRetiredTextures;
+            bool allocated = page->Allocate(paddedWidth, paddedHeight, &x, &y);
+            IM_ASSERT(allocated);
+            (void)allocated;
+            mPages.push_back(page);
+        }
+
+        auto region = std::make_shared<ImageAtlasRegion>();
+        region->page = page;
+        region->x = x + kGutter;
+        region->y = y + kGutter;
+        region->Width = width;
+        region->Height = height;
+        float pageSize = (float)mPageSize;
+        region->TextureUv0 = ImVec2((float)region->x / pageSize, (float)region->y / pageSize);
+        region->TextureUv1 = ImVec2((float)(region->x + width) / pageSize, (float)(region->y + height) / pageSize);
+        region->_impl_StoreTexture(width, height, const_cast<unsigned char*>(image_data_rgba));
+        return region;
+    }
+
+    bool ImageAtlas::FreeRetiredTextures()
+    {
+        bool hasRetiredTextures = !mRetiredTextures->empty();
+        mRetiredTextures->clear();
+        return hasRetiredTextures;
+    }
+
+    size_t ImageAtlas::ResidentBytes() const
+    {
+        size_t nbPages = (size_t)std::count_if(mPages.begin(), mPages.end(), [](const auto& page) { return !page.expired(); });
+        return nbPages * (size_t)mPageSize * (size_t)mPageSize * 4;
+    }
+
+    bool ImageAtlas::IsAtlasImage(const ImageAbstract* image)
+    {
+        return dynamic_cast<const ImageAtlasRegion*>(image) != nullptr;
+    }
+}
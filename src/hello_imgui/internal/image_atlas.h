@@ -0,0 +1,44 @@
+#pragma once
+#include "image_abstract.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace HelloImGui
+{
+    struct ImageAtlasPage;
+
+    // Packs small images into shared texture pages (see ImageFromAssetParams.atlasEnabled),
+    // so that ImGui can batch their draw calls.
+    //
+    // Pages are kept in CPU memory, and (re)uploaded lazily when their texture ID is requested
+    // after new images were added. Since ImTextureIDs that were already submitted in the current frame
+    // must stay valid until it is rendered, replaced page textures are kept alive until FreeRetiredTextures()
+    // (which shall be called at the start of the next frame).
+    // A page is freed when all its images are released; the space of a released image is not reused.
+    class ImageAtlas
+    {
+    public:
+        ImageAtlas(std::function<ImageAbstractPtr()> createPageTexture, int pageSize);
+        ~ImageAtlas();
+
+        // Returns an image stored in an atlas page, or nullptr if it is larger than a page.
+        // The returned image has TextureUv0/TextureUv1 set to its sub-rectangle inside the page.
+        ImageAbstractPtr AddImage(int width, int height, const unsigned char* image_data_rgba);
+
+        // Returns true if some textures were freed
+        bool FreeRetiredTextures();
+
+        // Size in bytes of the pages which are still used (pageSize * pageSize * 4 each)
+        size_t ResidentBytes() const;
+        // True if the image was returned by AddImage()
+        static bool IsAtlasImage(const ImageAbstract* image);
+
+    private:
+        std::function<ImageAbstractPtr()> mCreatePageTexture;
+        int mPageSize;
+        std::vector<std::weak_ptr<ImageAtlasPage>> mPages;
+        std::shared_ptr<std::vector<ImageAbstractPtr>> mRetiredTextures;
+    };
+}
@@ -6,6 +6,7 @@
 #include "image_dx11.h"
 #include "image_metal.h"
 #include "image_vulkan.h"
+#include "image_null.h"
 
 #include "hello_imgui/image_from_asset.h"
 #include "hello_imgui/hello_imgui_assets.h"
@@ -13,10 +14,18 @@
 #include "imgui.h"
 #include "hello_imgui/hello_imgui_assets.h"
 #include "hello_imgui/hello_imgui_logger.h"
+#include "hello_imgui/internal/image_atlas.h"
+#include "hello_imgui/internal/worker_pool.h"
 #include "stb_image.h"
 
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <stdexcept>
 #include <vector>
 
@@ -48,9 +57,75 @@ namespace HelloImGui
         return r;
     }
 
-    static std::unordered_map<std::string, ImageAbstractPtr > gImageFromAssetMap;
+    // ---------------------------------------------------------------------------------------------
+    // Image cache: images are stored by key (asset path + svg size), and ordered by recency of use
+    // (front = most recently used), so that the least recently used ones can be freed when
+    // ImageFromAssetParams.textureCacheMaxBytes is exceeded.
+    // ---------------------------------------------------------------------------------------------
+    struct CachedImage
+    {
+        ImageAbstractPtr image;  // nullptr if the loading failed
+        std::string assetPath;
+        size_t nbBytes = 0;      // 0 for atlas images, which are not counted in the budget
+        bool isInAtlas = false;  // atlas images are never evicted (this would not free their page)
+        int lastUsedFrame = 0;
+        std::list<std::string>::iterator lruIterator;
+    };
+
+    static std::unordered_map<std::string, CachedImage> gImageFromAssetMap;
+    static std::list<std::string> gImageFromAssetLru;
+    static std::unordered_set<std::string> gPinnedAssetPaths;
+    static ImageFromAssetCacheStats gImageFromAssetCacheStats;
+    static std::vector<std::string>* gUsedImagesRecorder = nullptr;
+    static uint64_t gImageTexturesGeneration = 0;
+
+    static void priv_RecordUsedImage(const std::string& key)
+    {
+        if (gUsedImagesRecorder == nullptr)
+            return;
+        if (std::find(gUsedImagesRecorder->begin(), gUsedImagesRecorder->end(), key) == gUsedImagesRecorder->end())
+            gUsedImagesRecorder->push_back(key);
+    }
+
+    static void priv_MarkAsRecentlyUsed(CachedImage& cachedImage)
+    {
+        cachedImage.lastUsedFrame = ImGui::GetFrameCount();
+        gImageFromAssetLru.splice(gImageFromAssetLru.begin(), gImageFromAssetLru, cachedImage.lruIterator);
+    }
 
-        static std::string priv_FilenameAndSizeKey(const char* assetPath, ImVec2 size)
+    // Returns the cached entry (and marks it as recently used), or nullptr
+    static CachedImage* priv_CacheFind(const std::string& key)
+    {
+        auto it = gImageFromAssetMap.find(key);
+        if (it == gImageFromAssetMap.end())
+            return nullptr;
+        CachedImage& cachedImage = it->second;
+        priv_MarkAsRecentlyUsed(cachedImage);
+        ++gImageFromAssetCacheStats.nbHits;
+        priv_RecordUsedImage(key);
+        return &cachedImage;
+    }
+
+    static void priv_CacheInsert(const std::string& key, const std::string& assetPath, const ImageAbstractPtr& image)
+    {
+        IM_ASSERT(gImageFromAssetMap.find(key) == gImageFromAssetMap.end());
+        CachedImage cachedImage;
+        cachedImage.image = image;
+        cachedImage.assetPath = assetPath;
+        cachedImage.isInAtlas = ImageAtlas::IsAtlasImage(image.get());
+        if (image && !cachedImage.isInAtlas)
+            cachedImage.nbBytes = (size_t)image->Width * (size_t)image->Height * 4;
+        cachedImage.lastUsedFrame = ImGui::GetFrameCount();
+        gImageFromAssetLru.push_front(key);
+        cachedImage.lruIterator = gImageFromAssetLru.begin();
+        gImageFromAssetCacheStats.residentBytes += cachedImage.nbBytes;
+        gImageFromAssetMap[key] = std::move(cachedImage);
+        priv_RecordUsedImage(key);
+        // Draw commands captured while this image was loading (or before it was loaded) are outdated
+        ++gImageTexturesGeneration;
+    }
+
+    static std::string priv_FilenameAndSizeKey(const char* assetPath, ImVec2 size)
     {
         std::string key = assetPath;
         key += "_";
@@ -65,12 +140,9 @@ namespace HelloImGui
         return filename.size() > 4 && filename.substr(filename.size() - 4) == ".svg";
     }
 
-    static ImageAbstractPtr _GetCachedImage(const char*assetPath, const unsigned char* data = nullptr, size_t len = 0, ImVec2 svgSize = ImVec2(0.f, 0.f))
+    // Creates an (empty) image for the current rendering backend
+    static ImageAbstractPtr priv_CreateConcreteImage()
     {
-        auto key = priv_FilenameAndSizeKey(assetPath, svgSize);
-        if (gImageFromAssetMap.find(key) != gImageFromAssetMap.end())
-            return gImageFromAssetMap.at(key);
-
         HelloImGui::RendererBackendType rendererBackendType = HelloImGui::GetRunnerParams()->rendererBackendType;
         ImageAbstractPtr concreteImage;
 
@@ -90,57 +162,292 @@ namespace HelloImGui
             if (rendererBackendType == RendererBackendType::DirectX11)
                 concreteImage = std::make_shared<ImageDx11>();
         #endif
-        if (concreteImage == nullptr)
-        {
-            HelloImGui::Log(LogLevel::Warning, "ImageFromAsset: not implemented for this rendering backend!");
-            gImageFromAssetMap[key] = nullptr; // Cache the failure
-            return nullptr;
-        }
+        if (rendererBackendType == RendererBackendType::Null)
+            concreteImage = std::make_shared<ImageNull>();
+        (void)rendererBackendType;
+        return concreteImage;
+    }
 
+    static bool priv_IsImageSupportedByBackend()
+    {
+        HelloImGui::RendererBackendType rendererBackendType = HelloImGui::GetRunnerParams()->rendererBackendType;
+        bool r = false;
+        #ifdef HELLOIMGUI_HAS_OPENGL
+            r = r || (rendererBackendType == RendererBackendType::OpenGL3);
+        #endif
+        #if defined(HELLOIMGUI_HAS_METAL)
+            r = r || (rendererBackendType == RendererBackendType::Metal);
+        #endif
+        #if defined(HELLOIMGUI_HAS_VULKAN)
+            r = r || (rendererBackendType == RendererBackendType::Vulkan);
+        #endif
+        #if defined(HELLOIMGUI_HAS_DIRECTX11)
+            r = r || (rendererBackendType == RendererBackendType::DirectX11);
+        #endif
+        // With the Null backend, images are only useful when they are drawn by the software rasterizer
+        r = r || (rendererBackendType == RendererBackendType::Null && SoftwareRasterizer::IsInitialized());
+        (void)rendererBackendType;
+        return r;
+    }
+
+    // RGBA pixels decoded from an asset (by stb_image or plutosvg)
+    struct DecodedImage
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> svgPixels;
+        std::unique_ptr<unsigned char, void(*)(void*)> stbPixels{nullptr, stbi_image_free};
+
+        unsigned char* Pixels() { return stbPixels ? stbPixels.get() : svgPixels.data(); }
+        bool IsValid() const { return (stbPixels != nullptr || !svgPixels.empty()) && width > 0 && height > 0; }
+    };
+
+    // Reads and decodes an asset (or the given data): this does not use the rendering backend,
+    // and can be called from any thread
+    static DecodedImage priv_DecodeImage(const std::string& assetPath, const unsigned char* data, size_t len, ImVec2 svgSize)
+    {
+        DecodedImage r;
         bool isSvg = priv_IsFilenameSvg(assetPath);
 
         if (!isSvg) {
-            unsigned char* image_data_rgba;
-            {
-                // Load the image using stbi_load_from_memory
-                auto assetData = LoadAssetFileData(assetPath);
-                IM_ASSERT(assetData.data != nullptr);
-                image_data_rgba = stbi_load_from_memory(
+            // Load the image using stbi_load_from_memory
+            if (data == nullptr) {
+                auto assetData = LoadAssetFileData(assetPath.c_str());
+                if (assetData.data == nullptr)
+                    return r;
+                unsigned char* image_data_rgba = stbi_load_from_memory(
                     (unsigned char *)assetData.data, (int)assetData.dataSize,
-                    &concreteImage->Width, &concreteImage->Height, NULL, 4);
+                    &r.width, &r.height, NULL, 4);
                 FreeAssetFileData(&assetData);
+                r.stbPixels.reset(image_data_rgba);
+            } else {
+                r.stbPixels.reset(stbi_load_from_memory(data, (int)len, &r.width, &r.height, NULL, 4));
             }
-
-            if (image_data_rgba == NULL)
-            {
-                IM_ASSERT(false && "_GetCachedImage: Failed to load image!");
-                throw std::runtime_error("_GetCachedImage: Failed to load image!");
-            }
-            concreteImage->_impl_StoreTexture(concreteImage->Width, concreteImage->Height, image_data_rgba);
-            stbi_image_free(image_data_rgba);
         } else {
             // Load SVG
             SvgRgbaImage svgRgbaImage;
+            if (data == nullptr) {
+                auto assetData = LoadAssetFileData(assetPath.c_str());
+                if (assetData.data == nullptr)
+                    return r;
+                svgRgbaImage = priv_SvgToRgba((const char*)assetData.data, assetData.dataSize, svgSize);
+                FreeAssetFileData(&assetData);
+            } else {
+                svgRgbaImage = priv_SvgToRgba((const char*)data, len, svgSize);
+            }
+            r.width = svgRgbaImage.width;
+            r.height = svgRgbaImage.height;
+            r.svgPixels = std::move(svgRgbaImage.data);
+        }
+        return r;
+    }
+
+    // Small images are packed into shared pages if ImageFromAssetParams.atlasEnabled
+    static std::unique_ptr<ImageAtlas> gImageAtlas;
+
+    // Uploads decoded pixels to a texture (or to an atlas page): shall be called from the render thread.
+    // Returns nullptr if the rendering backend does not support images
+    static ImageAbstractPtr priv_CreateTexture(DecodedImage& decodedImage)
+    {
+        if (!priv_IsImageSupportedByBackend())
+            return nullptr;
+
+        const auto& imageParams = GetRunnerParams()->imageFromAssetParams;
+        bool useAtlas = imageParams.atlasEnabled
+            && decodedImage.width <= imageParams.atlasMaxImageSize
+            && decodedImage.height <= imageParams.atlasMaxImageSize;
+        if (useAtlas)
+        {
+            if (!gImageAtlas)
+                gImageAtlas = std::make_unique<ImageAtlas>(priv_CreateConcreteImage, imageParams.atlasPageSize);
+            if (auto atlasImage = gImageAtlas->AddImage(decodedImage.width, decodedImage.height, decodedImage.Pixels()))
+                return atlasImage;
+        }
+
+        ImageAbstractPtr concreteImage = priv_CreateConcreteImage();
+        concreteImage->Width = decodedImage.width;
+        concreteImage->Height = decodedImage.height;
+        concreteImage->_impl_StoreTexture(concreteImage->Width, concreteImage->Height, decodedImage.Pixels());
+        return concreteImage;
+    }
+
+
+    // ---------------------------------------------------------------------------------------------
+    // Asynchronous loading (ImageFromAssetParams.asyncLoading):
+    //   - images are decoded by the worker threads of gAsyncDecodePool
+    //   - once decoded, they are pushed into gAsyncDecodedImages
+    //   - priv_UploadDecodedImages() (called once per frame by the runner)
+    //     uploads them to textures, within a per-frame budget, and stores them in gImageFromAssetMap
+    // ---------------------------------------------------------------------------------------------
+    struct AsyncDecodedImage
+    {
+        std::string key;
+        std::string assetPath;
+        DecodedImage decodedImage;
+    };
+
+    static std::unique_ptr<WorkerPool> gAsyncDecodePool;
+    static std::unordered_set<std::string> gAsyncPendingKeys; // only accessed by the main thread
+    static size_t gNbAsyncDecodesInFlight = 0;                  // only accessed by the main thread
+    static std::mutex gAsyncDecodedImagesMutex;
+    static std::deque<std::unique_ptr<AsyncDecodedImage>> gAsyncDecodedImages;
+
+    static void priv_StartAsyncDecode(const std::string& key, const char* assetPath, ImVec2 svgSize)
+    {
+        gAsyncPendingKeys.insert(key);
+        ++gNbAsyncDecodesInFlight;
+        if (!gAsyncDecodePool)
+            gAsyncDecodePool = std::make_unique<WorkerPool>(GetRunnerParams()->imageFromAssetParams.asyncNbWorkerThreads);
+
+        // Under Android, assets are read through SDL and the JNI: they are read by the main thread,
+        // and only decoded by the workers
+        std::vector<unsigned char> assetBytes;
+        #ifdef __ANDROID__
+        try
+        {
+            auto assetData = LoadAssetFileData(assetPath);
+            if (assetData.data != nullptr)
             {
-                // Load the image using stbi_load_from_memory
-                if (data == nullptr) {
-                    auto assetData = LoadAssetFileData(assetPath);
-                    IM_ASSERT(assetData.data != nullptr);
-                    svgRgbaImage = priv_SvgToRgba((const char*)assetData.data, assetData.dataSize, svgSize);
-                    FreeAssetFileData(&assetData);
-                } else {
-                    svgRgbaImage = priv_SvgToRgba((const char*)data, len, svgSize);
-                }
-                concreteImage->Height = svgRgbaImage.height;
-                concreteImage->Width = svgRgbaImage.width;
+                const unsigned char* bytes = (const unsigned char*)assetData.data;
+                assetBytes.assign(bytes, bytes + assetData.dataSize);
+                FreeAssetFileData(&assetData);
             }
-            concreteImage->_impl_StoreTexture(concreteImage->Width, concreteImage->Height, svgRgbaImage.data.data());
         }
+        catch (const std::exception&)
+        {
+            // Empty assetBytes will be reported as a failure by priv_UploadDecodedImages()
+        }
+        bool isAssetRead = true;
+        #else
+        bool isAssetRead = false;
+        #endif
 
-        gImageFromAssetMap[key] = concreteImage;
+        gAsyncDecodePool->Submit([key, assetPathStr = std::string(assetPath), svgSize, assetBytes = std::move(assetBytes), isAssetRead]()
+        {
+            auto r = std::make_unique<AsyncDecodedImage>();
+            r->key = key;
+            r->assetPath = assetPathStr;
+            try
+            {
+                if (!isAssetRead)
+                    r->decodedImage = priv_DecodeImage(assetPathStr, nullptr, 0, svgSize);
+                else if (!assetBytes.empty())
+                    r->decodedImage = priv_DecodeImage(assetPathStr, assetBytes.data(), assetBytes.size(), svgSize);
+            }
+            catch (const std::exception&)
+            {
+                // An invalid decodedImage will be reported as a failure by priv_UploadDecodedImages()
+            }
+            {
+                std::lock_guard<std::mutex> lock(gAsyncDecodedImagesMutex);
+                gAsyncDecodedImages.push_back(std::move(r));
+            }
+            // Display the image as soon as possible, even if the app is idling
+            HelloImGui::RequestRedraw();
+        });
+    }
+
+    static void priv_UploadDecodedImages()
+    {
+        if (gNbAsyncDecodesInFlight == 0)
+            return;
+
+        const auto& imageParams = GetRunnerParams()->imageFromAssetParams;
+        std::vector<std::unique_ptr<AsyncDecodedImage>> toUpload;
+        {
+            std::lock_guard<std::mutex> lock(gAsyncDecodedImagesMutex);
+            size_t nbBytes = 0;
+            while (!gAsyncDecodedImages.empty() && (int)toUpload.size() < std::max(imageParams.asyncMaxUploadsPerFrame, 1))
+            {
+                const auto& decodedImage = gAsyncDecodedImages.front()->decodedImage;
+                size_t imageBytes = (size_t)decodedImage.width * (size_t)decodedImage.height * 4;
+                bool isOverBudget = !toUpload.empty() && (nbBytes + imageBytes > imageParams.asyncMaxUploadBytesPerFrame);
+                if (isOverBudget)
+                    break;
+                nbBytes += imageBytes;
+                toUpload.push_back(std::move(gAsyncDecodedImages.front()));
+                gAsyncDecodedImages.pop_front();
+            }
+        }
+
+        for (auto& asyncDecodedImage : toUpload)
+        {
+            --gNbAsyncDecodesInFlight;
+            gAsyncPendingKeys.erase(asyncDecodedImage->key);
+            // The image may have been loaded synchronously in the meantime (e.g. by ImageFromExternalAsset)
+            if (gImageFromAssetMap.find(asyncDecodedImage->key) != gImageFromAssetMap.end())
+                continue;
+            ImageAbstractPtr concreteImage;
+            if (asyncDecodedImage->decodedImage.IsValid())
+                concreteImage = priv_CreateTexture(asyncDecodedImage->decodedImage);
+            else
+                HelloImGui::Log(LogLevel::Error, "ImageFromAsset: failed to load %s", asyncDecodedImage->assetPath.c_str());
+            priv_CacheInsert(asyncDecodedImage->key, asyncDecodedImage->assetPath, concreteImage); // Cache the failure, if any
+        }
+    }
+
+
+    // Returns the cached image, or loads it.
+    // If async loading is enabled, this may return nullptr with *outIsLoading=true while the image is being decoded
+    static ImageAbstractPtr _GetCachedImage(const char*assetPath, const unsigned char* data = nullptr, size_t len = 0, ImVec2 svgSize = ImVec2(0.f, 0.f), bool* outIsLoading = nullptr)
+    {
+        if (outIsLoading != nullptr)
+            *outIsLoading = false;
+
+        auto key = priv_FilenameAndSizeKey(assetPath, svgSize);
+        if (CachedImage* cachedImage = priv_CacheFind(key))
+            return cachedImage->image;
+
+        bool canLoadAsync = (data == nullptr) && GetRunnerParams()->imageFromAssetParams.asyncLoading;
+        if (canLoadAsync)
+        {
+            if (gAsyncPendingKeys.find(key) == gAsyncPendingKeys.end())
+            {
+                ++gImageFromAssetCacheStats.nbMisses;
+                priv_StartAsyncDecode(key, assetPath, svgSize);
+            }
+            if (outIsLoading != nullptr)
+                *outIsLoading = true;
+            return nullptr;
+        }
+
+        ++gImageFromAssetCacheStats.nbMisses;
+        // If this image is being decoded asynchronously, its decoded pixels will be dropped upon upload
+        gAsyncPendingKeys.erase(key);
+        if (!priv_IsImageSupportedByBackend())
+        {
+            HelloImGui::Log(LogLevel::Warning, "ImageFromAsset: not implemented for this rendering backend!");
+            priv_CacheInsert(key, assetPath, nullptr); // Cache the failure
+            return nullptr;
+        }
+
+        DecodedImage decodedImage = priv_DecodeImage(assetPath, data, len, svgSize);
+        if (!decodedImage.IsValid())
+        {
+            IM_ASSERT(false && "_GetCachedImage: Failed to load image!");
+            throw std::runtime_error("_GetCachedImage: Failed to load image!");
+        }
+        ImageAbstractPtr concreteImage = priv_CreateTexture(decodedImage);
+
+        priv_CacheInsert(key, assetPath, concreteImage);
         return concreteImage;
     }
 
+    // Maps a uv coordinate of the image to its texture (the image may be a sub-rectangle of an atlas page)
+    static ImVec2 priv_TextureUv(const ImageAbstract& image, const ImVec2& uv)
+    {
+        return ImVec2(
+            image.TextureUv0.x + uv.x * (image.TextureUv1.x - image.TextureUv0.x),
+            image.TextureUv0.y + uv.y * (image.TextureUv1.y - image.TextureUv0.y));
+    }
+
+    // While an image is being loaded asynchronously, reserve its space if its displayed size is known
+    static void priv_ShowImageLoadingPlaceholder(const ImVec2& size)
+    {
+        if (size.x > 0.f && size.y > 0.f)
+            ImGui::Dummy(size);
+    }
+
 
     void ImageFromAsset_Impl(
         const char *assetPath, const ImVec2& size,
@@ -150,7 +457,13 @@ namespace HelloImGui
         const ImVec4& border_col = ImVec4(0,0,0,0)
         )
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        bool isLoading;
+        auto cachedImage = _GetCachedImage(assetPath, nullptr, 0, ImVec2(0.f, 0.f), &isLoading);
+        if (isLoading)
+        {
+            priv_ShowImageLoadingPlaceholder(size);
+            return;
+        }
         if (cachedImage == nullptr)
         {
             ImGui::TextColored(ImVec4(1.f, 0.f, 0.f, 1.f), "ImageFromAsset: fail!");
@@ -159,10 +472,11 @@ namespace HelloImGui
         auto textureId = cachedImage->TextureID();
         auto imageSize = ImVec2((float)cachedImage->Width, (float)cachedImage->Height);
         ImVec2 displayedSize = ImageProportionalSize(size, imageSize);
+        ImVec2 textureUv0 = priv_TextureUv(*cachedImage, uv0), textureUv1 = priv_TextureUv(*cachedImage, uv1);
         if (withBg)
-            ImGui::ImageWithBg(textureId, displayedSize, uv0, uv1, tint_col, border_col);
+            ImGui::ImageWithBg(textureId, displayedSize, textureUv0, textureUv1, tint_col, border_col);
         else
-            ImGui::Image(textureId, displayedSize, uv0, uv1);
+            ImGui::Image(textureId, displayedSize, textureUv0, textureUv1);
     }
 
     void ImageFromExternalAsset_Impl(
@@ -183,10 +497,11 @@ namespace HelloImGui
         auto textureId = cachedImage->TextureID();
         auto imageSize = ImVec2((float)cachedImage->Width, (float)cachedImage->Height);
         ImVec2 displayedSize = ImageProportionalSize(size, imageSize);
+        ImVec2 textureUv0 = priv_TextureUv(*cachedImage, uv0), textureUv1 = priv_TextureUv(*cachedImage, uv1);
         if (withBg)
-            ImGui::ImageWithBg(textureId, displayedSize, uv0, uv1, tint_col, border_col);
+            ImGui::ImageWithBg(textureId, displayedSize, textureUv0, textureUv1, tint_col, border_col);
         else
-            ImGui::Image(textureId, displayedSize, uv0, uv1);
+            ImGui::Image(textureId, displayedSize, textureUv0, textureUv1);
     }
 
     void ImageFromAsset(
@@ -212,7 +527,13 @@ namespace HelloImGui
 
     bool ImageButtonFromAsset(const char *assetPath, const ImVec2& size, const ImVec2& uv0,  const ImVec2& uv1, int frame_padding, const ImVec4& bg_col, const ImVec4& tint_col)
     {
-        auto cachedImage = _GetCachedImage(assetPath);
+        bool isLoading;
+        auto cachedImage = _GetCachedImage(assetPath, nullptr, 0, ImVec2(0.f, 0.f), &isLoading);
+        if (isLoading)
+        {
+            priv_ShowImageLoadingPlaceholder(size);
+            return false;
+        }
         if (cachedImage == nullptr)
         {
             ImGui::TextColored(ImVec4(1.f, 0.f, 0.f, 1.f), "ImageButtonFromAsset: fail!");
@@ -221,7 +542,8 @@ namespace HelloImGui
         auto textureId = cachedImage->TextureID();
         auto imageSize = ImVec2((float)cachedImage->Width, (float)cachedImage->Height);
         ImVec2 displayedSize = ImageProportionalSize(size, imageSize);
-        bool clicked = ImGui::ImageButton(assetPath, textureId, displayedSize, uv0, uv1, bg_col, tint_col);
+        ImVec2 textureUv0 = priv_TextureUv(*cachedImage, uv0), textureUv1 = priv_TextureUv(*cachedImage, uv1);
+        bool clicked = ImGui::ImageButton(assetPath, textureId, displayedSize, textureUv0, textureUv1, bg_col, tint_col);
         return clicked;
     }
 
@@ -246,15 +568,106 @@ namespace HelloImGui
         auto cachedImage = _GetCachedImage(assetPath);
         if (cachedImage == nullptr)
             return {};
-        return {cachedImage->TextureID(), ImVec2((float)cachedImage->Width, (float)cachedImage->Height)};
+        return {cachedImage->TextureID(), ImVec2((float)cachedImage->Width, (float)cachedImage->Height),
+                cachedImage->TextureUv0, cachedImage->TextureUv1};
+    }
+
+    static void priv_EnforceCacheBudget()
+    {
+        size_t maxBytes = GetRunnerParams()->imageFromAssetParams.textureCacheMaxBytes;
+        if (maxBytes == 0)
+            return;
+
+        // Images used during the previous frame may still be referenced by the draw data
+        // (or be needed again right away): only older images are candidates for eviction.
+        int lastFrame = ImGui::GetFrameCount(); // ImGui::NewFrame() was not called yet
+        auto it = gImageFromAssetLru.end();
+        while (gImageFromAssetCacheStats.residentBytes > maxBytes && it != gImageFromAssetLru.begin())
+        {
+            --it;
+            auto mapIt = gImageFromAssetMap.find(*it);
+            IM_ASSERT(mapIt != gImageFromAssetMap.end());
+            const CachedImage& cachedImage = mapIt->second;
+            if (cachedImage.lastUsedFrame >= lastFrame)
+                break; // the next ones are even more recent
+            if (cachedImage.isInAtlas || gPinnedAssetPaths.count(cachedImage.assetPath) > 0)
+                continue;
+
+            gImageFromAssetCacheStats.residentBytes -= cachedImage.nbBytes;
+            ++gImageFromAssetCacheStats.nbEvictions;
+            gImageFromAssetMap.erase(mapIt);
+            it = gImageFromAssetLru.erase(it);
+            ++gImageTexturesGeneration;
+        }
     }
 
     namespace internal
     {
         void Free_ImageFromAssetMap()
         {
+            // Wait for the running decodes, and drop the pending ones
+            gAsyncDecodePool.reset();
+            {
+                std::lock_guard<std::mutex> lock(gAsyncDecodedImagesMutex);
+                gAsyncDecodedImages.clear();
+            }
+            gAsyncPendingKeys.clear();
+            gNbAsyncDecodesInFlight = 0;
+
             gImageFromAssetMap.clear();
+            gImageFromAssetLru.clear();
+            gImageFromAssetCacheStats.residentBytes = 0;
+            gImageAtlas.reset();
+            ++gImageTexturesGeneration;
         }
+
+        void PreNewFrame_ImageFromAssetMap()
+        {
+            priv_UploadDecodedImages();
+            // The previous frame was rendered: the page textures it replaced are not referenced anymore
+            if (gImageAtlas && gImageAtlas->FreeRetiredTextures())
+                ++gImageTexturesGeneration;
+            priv_EnforceCacheBudget();
+        }
+
+        std::vector<std::string>* SetUsedImagesRecorder(std::vector<std::string>* recorder)
+        {
+            std::vector<std::string>* previousRecorder = gUsedImagesRecorder;
+            gUsedImagesRecorder = recorder;
+            return previousRecorder;
+        }
+
+        void TouchImages(const std::vector<std::string>& keys)
+        {
+            for (const auto& key : keys)
+            {
+                auto it = gImageFromAssetMap.find(key);
+                if (it != gImageFromAssetMap.end())
+                    priv_MarkAsRecentlyUsed(it->second);
+                priv_RecordUsedImage(key);
+            }
+        }
+
+        uint64_t ImageTexturesGeneration()
+        {
+            return gImageTexturesGeneration;
+        }
+    }
+
+    ImageFromAssetCacheStats GetImageFromAssetCacheStats()
+    {
+        ImageFromAssetCacheStats r = gImageFromAssetCacheStats;
+        r.nbResidentImages = gImageFromAssetMap.size();
+        r.atlasBytes = gImageAtlas ? gImageAtlas->ResidentBytes() : 0;
+        return r;
+    }
+
+    void PinImageFromAsset(const char *assetPath, bool pinned)
+    {
+        if (pinned)
+            gPinnedAssetPaths.insert(assetPath);
+        else
+            gPinnedAssetPaths.erase(assetPath);
     }
 
 }
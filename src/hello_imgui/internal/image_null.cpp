@@ -0,0 +1,15 @@
+#include "image_null.h"
+
+
+namespace HelloImGui
+{
+    void ImageNull::_impl_StoreTexture(int width, int height, unsigned char* image_data_rgba)
+    {
+        Texture.Store(width, height, image_data_rgba);
+    }
+
+    ImTextureID ImageNull::TextureID()
+    {
+        return Texture.TextureID();
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "image_abstract.h"
+#include "hello_imgui/internal/backend_impls/software_rasterizer.h"
+#include <memory>
+
+namespace HelloImGui
+{
+    // Image for the Null rendering backend: its pixels are sampled by the SoftwareRasterizer
+    struct ImageNull: public ImageAbstract
+    {
+        ImageNull() = default;
+        ~ImageNull() override = default;
+
+        ImTextureID TextureID() override;
+        void _impl_StoreTexture(int width, int height, unsigned char* image_data_rgba) override;
+
+        SoftwareTexture Texture;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "imguial_term.h"
 #include "hello_imgui/icons_font_awesome_4.h"
+#include "imgui_internal.h"
 #include <algorithm>
 #include <ctype.h>
 #include <stdio.h>
@@ -91,6 +92,14 @@ void ImGuiAl::Crt::setMetaData(unsigned const meta_data) {
     _metaData = meta_data;
 }
 
+void ImGuiAl::Crt::setTimestamp(double const timestamp) {
+    _timestamp = timestamp;
+}
+
+void ImGuiAl::Crt::setThreadId(unsigned const thread_id) {
+    _threadId = thread_id;
+}
+
 void ImGuiAl::Crt::printf(char const* const format, ...) {
     va_list args;
     va_start(args, format);
@@ -113,24 +122,27 @@ void ImGuiAl::Crt::vprintf(char const* const format, va_list args) {
 
     if (length >= sizeof(temp)) {
         line = new char[length + 1];
-        ::vsnprintf(line, length, format, args_copy);
+        ::vsnprintf(line, length + 1, format, args_copy);
     }
 
     va_end(args_copy);
 
     while (length + sizeof(Info) > _fifo.available()) {
-        Info header;
-        _fifo.read(&header, sizeof(header));
-        _fifo.skip(header.length);
+        dropFirstRecord();
     }
 
     Info header;
     header.foregroundColor = _foregroundColor;
     header.length = static_cast<unsigned>(length);
     header.metaData = _metaData;
+    header.threadId = _threadId;
+    header.timestamp = _timestamp;
 
+    uint64_t const record_pos = _streamEnd;
     _fifo.write(&header, sizeof(header));
     _fifo.write(line, length);
+    _streamEnd += sizeof(header) + length;
+    indexRecord(record_pos, header, line);
 
     if (line != temp) {
         delete[] line;
@@ -146,6 +158,67 @@ void ImGuiAl::Crt::scrollToBottom() {
 
 void ImGuiAl::Crt::clear() {
     _fifo.reset();
+    _streamFirst = _streamEnd;
+    _firstRowNumber += _rows.size();
+    _rows.clear();
+    _filteredRows.clear();
+    _filterScannedUpTo = _firstRowNumber;
+}
+
+void ImGuiAl::Crt::indexRecord(uint64_t const recordPos, Info const& header, char const* const text) {
+    uint64_t const text_pos = recordPos + sizeof(Info);
+    unsigned row_start = 0;
+
+    for (unsigned i = 0; i <= header.length; i++) {
+        bool const is_end = i == header.length;
+
+        if (is_end || text[i] == '\n') {
+            // A trailing newline does not start a new row
+            if (is_end && row_start == header.length && row_start > 0) {
+                break;
+            }
+
+            Row row;
+            row.recordPos = recordPos;
+            row.textPos = text_pos + row_start;
+            row.length = i - row_start;
+            row.header = header;
+            _rows.push_back(row);
+            row_start = i + 1;
+        }
+    }
+}
+
+void ImGuiAl::Crt::dropFirstRecord() {
+    Info header;
+    _fifo.read(&header, sizeof(header));
+    _fifo.skip(header.length);
+
+    uint64_t const record_pos = _streamFirst;
+    _streamFirst += sizeof(header) + header.length;
+
+    while (!_rows.empty() && _rows.front().recordPos == record_pos) {
+        _rows.pop_front();
+        _firstRowNumber++;
+    }
+
+    while (!_filteredRows.empty() && _filteredRows.front() < _firstRowNumber) {
+        _filteredRows.pop_front();
+    }
+
+    if (_filterScannedUpTo < _firstRowNumber) {
+        _filterScannedUpTo = _firstRowNumber;
+    }
+}
+
+char const* ImGuiAl::Crt::rowText(Row const& row) {
+    if (_rowTextBuffer.size() < row.length + 1) {
+        _rowTextBuffer.resize(row.length + 1);
+    }
+
+    _fifo.peek(static_cast<size_t>(row.textPos - _streamFirst), _rowTextBuffer.data(), row.length);
+    _rowTextBuffer[row.length] = 0;
+    return _rowTextBuffer.data();
 }
 
 void ImGuiAl::Crt::iterate(const std::function<bool(Info const& header, char const* const line)>& iterator) const {
@@ -191,28 +264,98 @@ void ImGuiAl::Crt::iterate(const std::function<bool(Info const& header, char con
 }
 
 void ImGuiAl::Crt::draw(ImVec2 const& size) {
-    draw(size, [](Info const& header, char const* const line) -> bool {
-        (void)header;
-        (void)line;
-        return true;
-    });
-}
-
-void ImGuiAl::Crt::draw(ImVec2 const& size, const std::function<bool(Info const& header, char const* const line)>& filter) {
     char id[64];
     snprintf(id, sizeof(id), "ImGuiAl::Crt@%p", (void *)this);
 
     ImGui::BeginChild(id, size, false, ImGuiWindowFlags_HorizontalScrollbar);
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4.0f, 1.0f));
 
-    iterate([&filter](Info const& header, char const* const line) -> bool {
-        if (filter(header, line)) {
-            ImGui::PushStyleColor(ImGuiCol_Text, header.foregroundColor);
-            ImGui::TextUnformatted(line);
+    drawRows(_rows.size(), [this](size_t const i) -> Row const& { return _rows[i]; });
+
+    if (_scrollToBottom) {
+        ImGui::SetScrollHereY();
+        _scrollToBottom = false;
+    }
+
+    ImGui::PopStyleVar();
+    ImGui::EndChild();
+}
+
+void ImGuiAl::Crt::drawRows(size_t const count, const std::function<Row const&(size_t)>& rowAt) {
+    // Only the visible rows are read from the fifo and submitted
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(count));
+
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+            Row const& row = rowAt(static_cast<size_t>(i));
+
+            if (_showRecordInfo) {
+                // Only the first row of a record shows its info; the next ones are aligned
+                char info[48];
+                snprintf(info, sizeof(info), "%10.3f T%-3u ", row.header.timestamp, row.header.threadId);
+                bool const is_first_row = row.textPos == row.recordPos + sizeof(Info);
+                if (is_first_row) {
+                    ImGui::TextDisabled("%s", info);
+                    ImGui::SameLine(0.0f, 0.0f);
+                } else {
+                    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::CalcTextSize(info).x);
+                }
+            }
+
+            char const* const text = rowText(row);
+            ImGui::PushStyleColor(ImGuiCol_Text, row.header.foregroundColor);
+            ImGui::TextUnformatted(text, text + row.length);
             ImGui::PopStyleColor();
         }
+    }
+
+    clipper.End();
+}
+
+void ImGuiAl::Crt::updateFilteredRows(const std::function<bool(Info const& header, char const* const line)>& filter, uint64_t const filterKey) {
+    if (!_hasFilterCache || filterKey != _filterKey) {
+        _filteredRows.clear();
+        _filterScannedUpTo = _firstRowNumber;
+        _filterKey = filterKey;
+        _hasFilterCache = true;
+    }
 
-        return true;
+    // Only the rows added since the last call are filtered.
+    // The filter is applied to whole records: all the rows of a record share the same result
+    std::vector<char> record_text;
+    uint64_t last_record_pos = UINT64_MAX;
+    bool last_record_shown = false;
+
+    for (uint64_t n = _filterScannedUpTo; n < _firstRowNumber + _rows.size(); n++) {
+        Row const& row = _rows[static_cast<size_t>(n - _firstRowNumber)];
+
+        if (row.recordPos != last_record_pos) {
+            record_text.resize(row.header.length + 1);
+            _fifo.peek(static_cast<size_t>(row.recordPos + sizeof(Info) - _streamFirst), record_text.data(), row.header.length);
+            record_text[row.header.length] = 0;
+            last_record_shown = filter(row.header, record_text.data());
+            last_record_pos = row.recordPos;
+        }
+
+        if (last_record_shown) {
+            _filteredRows.push_back(n);
+        }
+    }
+
+    _filterScannedUpTo = _firstRowNumber + _rows.size();
+}
+
+void ImGuiAl::Crt::draw(ImVec2 const& size, const std::function<bool(Info const& header, char const* const line)>& filter, uint64_t const filterKey) {
+    char id[64];
+    snprintf(id, sizeof(id), "ImGuiAl::Crt@%p", (void *)this);
+
+    ImGui::BeginChild(id, size, false, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4.0f, 1.0f));
+
+    updateFilteredRows(filter, filterKey);
+    drawRows(_filteredRows.size(), [this](size_t const i) -> Row const& {
+        return _rows[static_cast<size_t>(_filteredRows[i] - _firstRowNumber)];
     });
 
     if (_scrollToBottom) {
@@ -408,7 +551,7 @@ int ImGuiAl::Log::draw(ImVec2 const& size, bool minimal)
 
     if (minimal)
     {
-        Crt::draw(size, [this](Info const& header, char const* const line) -> bool { return true; });
+        Crt::draw(size);
         return action;
     }
 
@@ -481,6 +624,9 @@ int ImGuiAl::Log::draw(ImVec2 const& size, bool minimal)
         ImGui::SameLine();
         ImGui::Checkbox(_cumulativeLabel, &_cumulative);
 
+        ImGui::SameLine();
+        ImGui::Checkbox("Timestamps##LogsTimestamps", &_showRecordInfo);
+
         ImGui::SameLine();
         if (ImGui::Button("Clear##LogsClear"))
             clear();
@@ -490,6 +636,10 @@ int ImGuiAl::Log::draw(ImVec2 const& size, bool minimal)
         _filter.Draw(_filterLabel);
     }
 
+    // The filter results are cached by Crt, until the level, the cumulative flag or the filter text change
+    uint64_t const filter_key = (static_cast<uint64_t>(ImHashStr(_filter.InputBuf)) << 8)
+        | (static_cast<uint64_t>(_level) << 1) | (_cumulative ? 1 : 0);
+
     Crt::draw(size, [this](Info const& header, char const* const line) -> bool {
         unsigned const level = static_cast<unsigned>(_level);
 
@@ -497,7 +647,7 @@ int ImGuiAl::Log::draw(ImVec2 const& size, bool minimal)
         show = show && _filter.PassFilter(line);
 
         return show;
-    });
+    }, filter_key);
 
 
     return action;
@@ -30,7 +30,9 @@ SOFTWARE.
 #include <stdarg.h>
 #include <stdint.h>
 
+#include <deque>
 #include <functional>
+#include <vector>
 
 namespace ImGuiAl {
 class Fifo {
@@ -82,12 +84,18 @@ class Crt {
         ImU32 foregroundColor;
         unsigned length;
         unsigned metaData;
+        unsigned threadId;
+        double timestamp;
     };
 
     Crt(void* const buffer, size_t const size);
 
     void setForegroundColor(ImU32 const color);
     void setMetaData(unsigned const meta_data);
+    void setTimestamp(double const timestamp);
+    void setThreadId(unsigned const thread_id);
+    // If true, each record is prefixed by its timestamp and thread id
+    void setShowRecordInfo(bool const show) { _showRecordInfo = show; }
 
     void printf(char const* const format, ...);
     void vprintf(char const* const format, va_list args);
@@ -98,13 +106,47 @@ class Crt {
     void draw(ImVec2 const& size = ImVec2(0.0f, 0.0f));
 
    protected:
-    void draw(ImVec2 const& size, const std::function<bool(Info const& header, char const* const line)>& filter);
+    // filterKey identifies the state of the filter: its results are cached until filterKey changes
+    void draw(ImVec2 const& size, const std::function<bool(Info const& header, char const* const line)>& filter, uint64_t filterKey);
+
+    // A displayed row: a line of a record (records may contain several lines)
+    struct Row {
+        uint64_t recordPos;  // stream position of the record header
+        uint64_t textPos;    // stream position of the row text
+        unsigned length;
+        Info header;
+    };
+
+    void indexRecord(uint64_t recordPos, Info const& header, char const* const text);
+    void dropFirstRecord();
+    char const* rowText(Row const& row);
+    void drawRows(size_t count, const std::function<Row const&(size_t)>& rowAt);
+    void updateFilteredRows(const std::function<bool(Info const& header, char const* const line)>& filter, uint64_t filterKey);
 
     Fifo _fifo;
     ImU32 _foregroundColor;
     unsigned _metaData;
+    unsigned _threadId = 0;
+    double _timestamp = 0.0;
+    bool _showRecordInfo = false;
     bool _scrollToBottom;
     bool autoScrollToBotttom = false;
+
+    // Stream positions: total number of bytes written to / removed from the fifo since the creation
+    uint64_t _streamFirst = 0;
+    uint64_t _streamEnd = 0;
+
+    // Line index, updated incrementally in vprintf, so that draw() only reads the visible rows
+    std::deque<Row> _rows;
+    uint64_t _firstRowNumber = 0;  // absolute number of _rows.front()
+
+    // Cached filter results (absolute row numbers)
+    std::deque<uint64_t> _filteredRows;
+    uint64_t _filterScannedUpTo = 0;
+    uint64_t _filterKey = 0;
+    bool _hasFilterCache = false;
+
+    std::vector<char> _rowTextBuffer;
 };
 
 class Log : protected Crt {
@@ -143,6 +185,8 @@ class Log : protected Crt {
     void setFilterHeaderLabel(char const* const label);
     void setActions(char const* actions[]);
     void setColorsAutoFromWindowBg();
+    void setTimestamp(double const timestamp) { Crt::setTimestamp(timestamp); }
+    void setThreadId(unsigned const thread_id) { Crt::setThreadId(thread_id); }
 
    protected:
     ImU32 _debugTextColor;
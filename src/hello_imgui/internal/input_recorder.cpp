@@ -0,0 +1,275 @@
+#include "hello_imgui/internal/input_recorder.h"
+#include "imgui.h"
+#include "hello_imgui/internal/imgui_global_context.h" // must be included before imgui_internal.h
+#include "imgui_internal.h"
+
+#include <cstdio>
+#include <cstring>
+
+
+namespace HelloImGui
+{
+    static const char kTraceMagic[4] = {'H', 'I', 'I', 'R'};
+    static const uint32_t kTraceVersion = 1;
+
+    struct InputTraceFrameHeader
+    {
+        float deltaTime;
+        float displaySize[2];
+        float framebufferScale[2];
+        uint32_t nbEvents;
+    };
+    static_assert(sizeof(InputTraceEvent) == 16, "InputTraceEvent shall be a packed 16 bytes structure");
+    static_assert(sizeof(InputTraceFrameHeader) == 24, "InputTraceFrameHeader shall be a packed 24 bytes structure");
+
+
+    bool WriteInputTrace(const std::string& filename, const std::vector<InputTraceFrame>& frames)
+    {
+        FILE* f = fopen(filename.c_str(), "wb");
+        if (f == nullptr)
+        {
+            fprintf(stderr, "HelloImGui: cannot write input trace %s\n", filename.c_str());
+            return false;
+        }
+        bool ok = fwrite(kTraceMagic, sizeof(kTraceMagic), 1, f) == 1;
+        ok = ok && fwrite(&kTraceVersion, sizeof(kTraceVersion), 1, f) == 1;
+        for (const auto& frame : frames)
+        {
+            InputTraceFrameHeader header;
+            header.deltaTime = frame.deltaTime;
+            memcpy(header.displaySize, frame.displaySize, sizeof(header.displaySize));
+            memcpy(header.framebufferScale, frame.framebufferScale, sizeof(header.framebufferScale));
+            header.nbEvents = (uint32_t)frame.events.size();
+            ok = ok && fwrite(&header, sizeof(header), 1, f) == 1;
+            if (!frame.events.empty())
+                ok = ok && fwrite(frame.events.data(), sizeof(InputTraceEvent), frame.events.size(), f) == frame.events.size();
+        }
+        ok = (fclose(f) == 0) && ok;
+        if (!ok)
+            fprintf(stderr, "HelloImGui: error while writing input trace %s\n", filename.c_str());
+        return ok;
+    }
+
+    bool ReadInputTrace(const std::string& filename, std::vector<InputTraceFrame>* outFrames)
+    {
+        outFrames->clear();
+        FILE* f = fopen(filename.c_str(), "rb");
+        if (f == nullptr)
+        {
+            fprintf(stderr, "HelloImGui: cannot read input trace %s\n", filename.c_str());
+            return false;
+        }
+        char magic[4];
+        uint32_t version = 0;
+        bool ok = fread(magic, sizeof(magic), 1, f) == 1 && memcmp(magic, kTraceMagic, sizeof(magic)) == 0;
+        ok = ok && fread(&version, sizeof(version), 1, f) == 1 && version == kTraceVersion;
+        if (!ok)
+            fprintf(stderr, "HelloImGui: %s is not an input trace (or has an unsupported version)\n", filename.c_str());
+
+        InputTraceFrameHeader header;
+        while (ok && fread(&header, sizeof(header), 1, f) == 1)
+        {
+            InputTraceFrame frame;
+            frame.deltaTime = header.deltaTime;
+            memcpy(frame.displaySize, header.displaySize, sizeof(frame.displaySize));
+            memcpy(frame.framebufferScale, header.framebufferScale, sizeof(frame.framebufferScale));
+            frame.events.resize(header.nbEvents);
+            if (header.nbEvents > 0 && fread(frame.events.data(), sizeof(InputTraceEvent), header.nbEvents, f) != header.nbEvents)
+            {
+                fprintf(stderr, "HelloImGui: truncated input trace %s\n", filename.c_str());
+                ok = false;
+                break;
+            }
+            outFrames->push_back(std::move(frame));
+        }
+        fclose(f);
+        return ok;
+    }
+
+
+    namespace InputRecorder
+    {
+        struct InputRecorderStatics
+        {
+            bool isRecording = false;
+            std::string recordFilename;
+            ImU32 nextEventIdToRecord = 0;
+
+            bool isReplaying = false;
+            float fixedTimestep = 0.f;
+            size_t idxReplayFrame = 0;
+
+            std::vector<InputTraceFrame> frames; // recorded, or being replayed
+        };
+        static InputRecorderStatics gStatics;
+
+
+        static InputTraceEvent ToTraceEvent(const ImGuiInputEvent& e)
+        {
+            InputTraceEvent r;
+            r.type = (uint8_t)e.Type;
+            r.source = (uint8_t)e.Source;
+            switch (e.Type)
+            {
+                case ImGuiInputEventType_MousePos:
+                    r.x = e.MousePos.PosX;
+                    r.y = e.MousePos.PosY;
+                    r.mouseSource = (uint8_t)e.MousePos.MouseSource;
+                    break;
+                case ImGuiInputEventType_MouseWheel:
+                    r.x = e.MouseWheel.WheelX;
+                    r.y = e.MouseWheel.WheelY;
+                    r.mouseSource = (uint8_t)e.MouseWheel.MouseSource;
+                    break;
+                case ImGuiInputEventType_MouseButton:
+                    r.code = (uint32_t)e.MouseButton.Button;
+                    r.down = e.MouseButton.Down ? 1 : 0;
+                    r.mouseSource = (uint8_t)e.MouseButton.MouseSource;
+                    break;
+            #ifdef IMGUI_HAS_VIEWPORT
+                case ImGuiInputEventType_MouseViewport:
+                    r.code = (uint32_t)e.MouseViewport.HoveredViewportID;
+                    break;
+            #endif
+                case ImGuiInputEventType_Key:
+                    r.code = (uint32_t)e.Key.Key;
+                    r.down = e.Key.Down ? 1 : 0;
+                    r.x = e.Key.AnalogValue;
+                    break;
+                case ImGuiInputEventType_Text:
+                    r.code = (uint32_t)e.Text.Char;
+                    break;
+                case ImGuiInputEventType_Focus:
+                    r.down = e.AppFocused.Focused ? 1 : 0;
+                    break;
+                default:
+                    break;
+            }
+            return r;
+        }
+
+        static void AddTraceEventToIo(const InputTraceEvent& e)
+        {
+            ImGuiIO& io = ImGui::GetIO();
+            switch ((ImGuiInputEventType)e.type)
+            {
+                case ImGuiInputEventType_MousePos:
+                    io.AddMouseSourceEvent((ImGuiMouseSource)e.mouseSource);
+                    io.AddMousePosEvent(e.x, e.y);
+                    break;
+                case ImGuiInputEventType_MouseWheel:
+                    io.AddMouseSourceEvent((ImGuiMouseSource)e.mouseSource);
+                    io.AddMouseWheelEvent(e.x, e.y);
+                    break;
+                case ImGuiInputEventType_MouseButton:
+                    io.AddMouseSourceEvent((ImGuiMouseSource)e.mouseSource);
+                    io.AddMouseButtonEvent((int)e.code, e.down != 0);
+                    break;
+            #ifdef IMGUI_HAS_VIEWPORT
+                case ImGuiInputEventType_MouseViewport:
+                    io.AddMouseViewportEvent((ImGuiID)e.code);
+                    break;
+            #endif
+                case ImGuiInputEventType_Key:
+                    io.AddKeyAnalogEvent((ImGuiKey)e.code, e.down != 0, e.x);
+                    break;
+                case ImGuiInputEventType_Text:
+                    io.AddInputCharacter(e.code);
+                    break;
+                case ImGuiInputEventType_Focus:
+                    io.AddFocusEvent(e.down != 0);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        static void RecordFrame()
+        {
+            ImGuiContext& g = *GImGui;
+            ImGuiIO& io = g.IO;
+            InputTraceFrame frame;
+            frame.deltaTime = io.DeltaTime;
+            frame.displaySize[0] = io.DisplaySize.x;
+            frame.displaySize[1] = io.DisplaySize.y;
+            frame.framebufferScale[0] = io.DisplayFramebufferScale.x;
+            frame.framebufferScale[1] = io.DisplayFramebufferScale.y;
+            // Events which were not processed during the previous frame (see io.ConfigInputTrickleEventQueue)
+            // are still in the queue: only record the new ones
+            for (const ImGuiInputEvent& e : g.InputEventsQueue)
+                if (e.EventId >= gStatics.nextEventIdToRecord)
+                    frame.events.push_back(ToTraceEvent(e));
+            gStatics.nextEventIdToRecord = g.InputEventsNextEventId;
+            gStatics.frames.push_back(std::move(frame));
+        }
+
+        static void ReplayFrame()
+        {
+            if (IsReplayFinished())
+                return;
+            const InputTraceFrame& frame = gStatics.frames[gStatics.idxReplayFrame++];
+            ImGuiIO& io = ImGui::GetIO();
+            io.DeltaTime = gStatics.fixedTimestep > 0.f ? gStatics.fixedTimestep : frame.deltaTime;
+            io.DisplaySize = ImVec2(frame.displaySize[0], frame.displaySize[1]);
+            io.DisplayFramebufferScale = ImVec2(frame.framebufferScale[0], frame.framebufferScale[1]);
+            for (const auto& e : frame.events)
+                AddTraceEventToIo(e);
+        }
+
+
+        void StartRecording(const std::string& filename)
+        {
+            gStatics.isRecording = true;
+            gStatics.recordFilename = filename;
+            gStatics.frames.clear();
+            gStatics.nextEventIdToRecord = 0;
+        }
+
+        void StopRecording()
+        {
+            if (!gStatics.isRecording)
+                return;
+            gStatics.isRecording = false;
+            WriteInputTrace(gStatics.recordFilename, gStatics.frames);
+            gStatics.frames.clear();
+        }
+
+        bool IsRecording() { return gStatics.isRecording; }
+
+        bool StartReplay(const std::string& filename, float fixedTimestep)
+        {
+            IM_ASSERT(!gStatics.isRecording && "InputRecorder: cannot record and replay at the same time");
+            if (!ReadInputTrace(filename, &gStatics.frames))
+            {
+                gStatics.frames.clear();
+                return false;
+            }
+            gStatics.isReplaying = true;
+            gStatics.fixedTimestep = fixedTimestep;
+            gStatics.idxReplayFrame = 0;
+            return true;
+        }
+
+        void StopReplay()
+        {
+            gStatics.isReplaying = false;
+            gStatics.frames.clear();
+            gStatics.idxReplayFrame = 0;
+        }
+
+        bool IsReplaying() { return gStatics.isReplaying; }
+
+        bool IsReplayFinished()
+        {
+            return gStatics.isReplaying && gStatics.idxReplayFrame >= gStatics.frames.size();
+        }
+
+        void OnPreImGuiNewFrame()
+        {
+            if (gStatics.isRecording)
+                RecordFrame();
+            else if (gStatics.isReplaying)
+                ReplayFrame();
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    // One input event, as found in ImGui's input queue (ImGuiInputEvent), in a compact and portable form.
+    // The meaning of code/x/y depends on the type:
+    //     MousePos: x, y          MouseWheel: x, y          MouseButton: code=button, down
+    //     MouseViewport: code=ID  Key: code=ImGuiKey, down, x=analog value
+    //     Text: code=character    Focus: down=focused
+    struct InputTraceEvent
+    {
+        uint8_t  type = 0;         // ImGuiInputEventType
+        uint8_t  source = 0;       // ImGuiInputSource
+        uint8_t  mouseSource = 0;  // ImGuiMouseSource
+        uint8_t  down = 0;
+        uint32_t code = 0;
+        float    x = 0.f;
+        float    y = 0.f;
+    };
+
+    // The inputs of one frame, as seen just before ImGui::NewFrame()
+    struct InputTraceFrame
+    {
+        float deltaTime = 0.f;
+        float displaySize[2] = {0.f, 0.f};
+        float framebufferScale[2] = {1.f, 1.f};
+        std::vector<InputTraceEvent> events;
+    };
+
+    // Binary input traces: a header ("HIIR" + version), followed by the frames
+    // (a fixed size frame header, followed by the frame events)
+    bool WriteInputTrace(const std::string& filename, const std::vector<InputTraceFrame>& frames);
+    bool ReadInputTrace(const std::string& filename, std::vector<InputTraceFrame>* outFrames);
+
+
+    // InputRecorder records the inputs received by ImGui during a session
+    // (see RunnerParams.inputRecordFile), and can replay them later (see RunnerParams.inputReplayFile),
+    // typically with the Null backend, to obtain reproducible runs.
+    namespace InputRecorder
+    {
+        void StartRecording(const std::string& filename);
+        // Writes the recorded frames to the file
+        void StopRecording();
+        bool IsRecording();
+
+        // Returns false if the trace could not be loaded
+        bool StartReplay(const std::string& filename, float fixedTimestep);
+        void StopReplay();
+        bool IsReplaying();
+        bool IsReplayFinished();
+
+        // To be called just before ImGui::NewFrame():
+        // - when recording, stores the events added since the previous frame, the display size and io.DeltaTime
+        // - when replaying, feeds the next recorded frame into ImGui's io
+        //   (with io.DeltaTime = fixedTimestep, or the recorded DeltaTime if fixedTimestep <= 0)
+        void OnPreImGuiNewFrame();
+    }
+}
@@ -0,0 +1,152 @@
+#include "hello_imgui/internal/log_file_sink.h"
+
+#include <algorithm>
+
+namespace HelloImGui
+{
+    // On disk, each record is a RecordHeader followed by the message (not null terminated)
+    struct RecordHeader
+    {
+        uint32_t messageLength;
+        uint32_t threadId;
+        uint32_t level;
+        uint32_t reserved;
+        double timestamp;
+    };
+    static_assert(sizeof(RecordHeader) == 24, "RecordHeader should not be padded");
+
+    LogFileSink::~LogFileSink()
+    {
+        Close();
+    }
+
+    std::string LogFileSink::FilePath(size_t fileIndex) const
+    {
+        if (fileIndex == 0)
+            return mParams.filename;
+        return mParams.filename + "." + std::to_string(fileIndex);
+    }
+
+    bool LogFileSink::Open(const LogFileSinkParams& params)
+    {
+        Close();
+        mParams = params;
+        mParams.maxFiles = std::max(mParams.maxFiles, 1);
+
+        // The history starts with the sink: remove the files of a previous session
+        for (size_t i = 1; i < (size_t)mParams.maxFiles; ++i)
+            std::remove(FilePath(i).c_str());
+
+        mFile = fopen(mParams.filename.c_str(), "wb");
+        if (mFile == nullptr)
+            return false;
+        mFileBytes = 0;
+        mRecordOffsets.clear();
+        mRecordOffsets.emplace_back();
+        return true;
+    }
+
+    void LogFileSink::Close()
+    {
+        if (mFile != nullptr)
+        {
+            fclose(mFile);
+            mFile = nullptr;
+        }
+        mRecordOffsets.clear();
+    }
+
+    void LogFileSink::Rotate()
+    {
+        fclose(mFile);
+        std::remove(FilePath((size_t)mParams.maxFiles - 1).c_str());
+        for (size_t i = (size_t)mParams.maxFiles - 1; i >= 1; --i)
+            std::rename(FilePath(i - 1).c_str(), FilePath(i).c_str());
+
+        mFile = fopen(mParams.filename.c_str(), "wb");
+        mFileBytes = 0;
+        mRecordOffsets.emplace_front();
+        while (mRecordOffsets.size() > (size_t)mParams.maxFiles)
+            mRecordOffsets.pop_back();
+    }
+
+    void LogFileSink::Append(const LogRecord& record)
+    {
+        if (mFile == nullptr)
+            return;
+        if (mFileBytes > 0 && mFileBytes + sizeof(RecordHeader) + record.message.size() > mParams.maxFileBytes)
+        {
+            Rotate();
+            if (mFile == nullptr)
+                return;
+        }
+
+        RecordHeader header;
+        header.messageLength = (uint32_t)record.message.size();
+        header.threadId = record.threadId;
+        header.level = (uint32_t)record.level;
+        header.reserved = 0;
+        header.timestamp = record.timestamp;
+
+        mRecordOffsets.front().push_back(mFileBytes);
+        fwrite(&header, sizeof(header), 1, mFile);
+        fwrite(record.message.data(), 1, record.message.size(), mFile);
+        mFileBytes += sizeof(header) + record.message.size();
+    }
+
+    size_t LogFileSink::NbRecords() const
+    {
+        size_t r = 0;
+        for (const auto& offsets: mRecordOffsets)
+            r += offsets.size();
+        return r;
+    }
+
+    std::vector<LogRecord> LogFileSink::ReadPage(size_t pageIndex, size_t pageSize)
+    {
+        std::vector<LogRecord> r;
+        size_t nbRecords = NbRecords();
+        if (mFile == nullptr || pageSize == 0 || pageIndex * pageSize >= nbRecords)
+            return r;
+        fflush(mFile);
+
+        // Record numbers, counted from the oldest record
+        size_t last = nbRecords - pageIndex * pageSize;
+        size_t first = last > pageSize ? last - pageSize : 0;
+        r.reserve(last - first);
+
+        // Files are stored from the newest to the oldest: walk them from the oldest
+        size_t fileFirstRecord = 0;
+        for (size_t fileIndex = mRecordOffsets.size(); fileIndex-- > 0; )
+        {
+            const auto& offsets = mRecordOffsets[fileIndex];
+            size_t fileLastRecord = fileFirstRecord + offsets.size();
+            size_t readFirst = std::max(first, fileFirstRecord), readLast = std::min(last, fileLastRecord);
+            if (readFirst < readLast)
+            {
+                FILE* f = fopen(FilePath(fileIndex).c_str(), "rb");
+                if (f != nullptr)
+                {
+                    fseek(f, (long)offsets[readFirst - fileFirstRecord], SEEK_SET);
+                    for (size_t i = readFirst; i < readLast; ++i)
+                    {
+                        RecordHeader header;
+                        if (fread(&header, sizeof(header), 1, f) != 1)
+                            break;
+                        LogRecord record;
+                        record.level = (LogLevel)header.level;
+                        record.threadId = header.threadId;
+                        record.timestamp = header.timestamp;
+                        record.message.resize(header.messageLength);
+                        if (header.messageLength > 0 && fread(&record.message[0], 1, header.messageLength, f) != header.messageLength)
+                            break;
+                        r.push_back(std::move(record));
+                    }
+                    fclose(f);
+                }
+            }
+            fileFirstRecord = fileLastRecord;
+        }
+        return r;
+    }
+}
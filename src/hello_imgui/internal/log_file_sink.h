@@ -0,0 +1,43 @@
+#pragma once
+#include "hello_imgui/hello_imgui_logger.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace HelloImGui
+{
+    // A rotating binary file sink for the log records (see LogOpenFileSink).
+    //
+    // Records are appended to `filename`; when it exceeds maxFileBytes, it is renamed to `filename.1`
+    // (and `filename.1` to `filename.2`, etc.), and at most maxFiles files are kept.
+    // The offsets of the records are kept in memory, so that any page of the history can be read back.
+    // This class is not thread safe (it is protected by the log mutex).
+    class LogFileSink
+    {
+    public:
+        ~LogFileSink();
+
+        bool Open(const LogFileSinkParams& params);
+        void Close();
+        bool IsOpen() const { return mFile != nullptr; }
+
+        void Append(const LogRecord& record);
+
+        size_t NbRecords() const;
+        // Page 0 contains the most recent records; records inside a page are ordered from oldest to newest
+        std::vector<LogRecord> ReadPage(size_t pageIndex, size_t pageSize);
+
+    private:
+        std::string FilePath(size_t fileIndex) const;
+        void Rotate();
+
+        LogFileSinkParams mParams;
+        FILE* mFile = nullptr;
+        uint64_t mFileBytes = 0;
+        // mRecordOffsets[i]: offsets of the records inside FilePath(i) (0 = current file, 1 = previous one, ...)
+        std::deque<std::vector<uint64_t>> mRecordOffsets;
+    };
+}
@@ -1,6 +1,8 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "hello_imgui/internal/menu_statusbar.h"
 #include "hello_imgui/internal/docking_details.h"
+#include "hello_imgui/internal/frame_profiler.h"
+#include "hello_imgui/internal/gui_cost_profiler.h"
 
 #include "imgui.h"
 #include "hello_imgui/internal/imgui_global_context.h" // must be included before imgui_internal.h
@@ -65,12 +67,30 @@ void ShowMenu(RunnerParams & runnerParams)
         DockingDetails::ShowViewMenu(runnerParams);
 
     if (runnerParams.callbacks.ShowMenus)
+    {
+        GuiCostScope guiCostScope("[ShowMenus]", GuiCostKind::Callback);
         runnerParams.callbacks.ShowMenus();
+    }
 
     ImGui::EndMainMenuBar();
 }
 
 
+static void ShowFrameStatsTooltip_IfHovered()
+{
+    if (!ImGui::IsItemHovered())
+        return;
+    FrameStats stats = GetFrameStats();
+    ImGui::BeginTooltip();
+    ImGui::Text("Last %d frames (ms)", stats.nbFrames);
+    ImGui::Separator();
+    ImGui::Text("min  %7.2f   max %7.2f", stats.minFrameTime * 1000., stats.maxFrameTime * 1000.);
+    ImGui::Text("mean %7.2f   p50 %7.2f", stats.meanFrameTime * 1000., stats.p50FrameTime * 1000.);
+    ImGui::Text("p95  %7.2f   p99 %7.2f", stats.p95FrameTime * 1000., stats.p99FrameTime * 1000.);
+    ImGui::Text("Frames over 1/60s: %d", stats.nbJankFrames);
+    ImGui::EndTooltip();
+}
+
 void ShowStatusBar(RunnerParams & params)
 {
     float statusWindowHeight = ImGui::GetFrameHeight() * 1.4f;
@@ -95,7 +115,19 @@ void ShowStatusBar(RunnerParams & params)
     ImGui::Begin("StatusBar", nullptr, windowFlags);
 
     if (params.callbacks.ShowStatus)
+    {
+        GuiCostScope guiCostScope("[ShowStatus]", GuiCostKind::Callback);
         params.callbacks.ShowStatus();
+    }
+
+    if (params.imGuiWindowParams.showStatus_FrameProfiler)
+    {
+        // The timeline is displayed on the left of the FPS info
+        float fpsInfoWidth = params.imGuiWindowParams.showStatus_Fps ? (ShouldRemoteDisplay() ? 5.f : 14.f) : 0.f;
+        float timelineWidth = 12.f;
+        ImGui::SameLine(ImGui::GetIO().DisplaySize.x - (fpsInfoWidth + timelineWidth + 0.5f) * ImGui::GetFontSize());
+        FrameProfiler::ShowTimeline(ImVec2(timelineWidth * ImGui::GetFontSize(), ImGui::GetFrameHeight()));
+    }
 
     if (params.imGuiWindowParams.showStatus_Fps)
     {
@@ -103,6 +135,7 @@ void ShowStatusBar(RunnerParams & params)
 		{
 			ImGui::SameLine(ImGui::GetIO().DisplaySize.x - 5.f * ImGui::GetFontSize());
 			ImGui::Text("FPS: %.1f", HelloImGui::FrameRate());
+			ShowFrameStatsTooltip_IfHovered();
 		}
 		else
 		{
@@ -115,6 +148,7 @@ void ShowStatusBar(RunnerParams & params)
 			ImGui::SameLine();
 			ImGui::SetCursorPosY(ImGui::GetCursorPosY() - dy);
 			ImGui::Text("FPS: %.1f%s", HelloImGui::FrameRate(), idlingInfo);
+			ShowFrameStatsTooltip_IfHovered();
 		}
     }
 
@@ -0,0 +1,246 @@
+#include "hello_imgui/internal/startup_pipeline.h"
+#include "hello_imgui/internal/asset_prefetch.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/internal/hello_imgui_ini_any_parent_folder.h"
+#include "hello_imgui/internal/hello_imgui_ini_settings.h"
+#include "hello_imgui/internal/trace_exporter.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Under emscripten, threads are only available when built with HELLOIMGUI_EMSCRIPTEN_PTHREAD
+#if defined(__EMSCRIPTEN__) && !defined(HELLOIMGUI_EMSCRIPTEN_PTHREAD)
+#define HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+#endif
+
+#ifndef HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+#include <system_error>
+#include <thread>
+#endif
+
+namespace HelloImGui
+{
+    namespace ImGuiDefaultSettings
+    {
+        std::vector<std::string> DefaultFontAssetFiles(DefaultIconFont defaultIconFont); // from imgui_default_settings.cpp
+    }
+
+    const char* StartupPhaseName(StartupPhase phase)
+    {
+        switch (phase)
+        {
+            case StartupPhase::InitImGuiContext: return "ImGui context";
+            case StartupPhase::InitPlatformBackend: return "Platform backend";
+            case StartupPhase::CreateWindow: return "Create window";
+            case StartupPhase::InitRenderer: return "Renderer";
+            case StartupPhase::SetupDpi: return "DPI";
+            case StartupPhase::PostInit: return "PostInit";
+            case StartupPhase::LoadFonts: return "Load fonts";
+            case StartupPhase::LoadSettings: return "Load settings";
+            case StartupPhase::ApplyTheme: return "Theme";
+            case StartupPhase::Finalize: return "Finalize";
+            default: return "Unknown";
+        }
+    }
+
+    double StartupTimings::TotalDuration() const
+    {
+        double total = 0.;
+        for (double duration : phaseDurations)
+            total += duration;
+        return total;
+    }
+
+
+    namespace StartupPipeline
+    {
+        constexpr int NbPhases = (int)StartupPhase::Count;
+
+        // A prefetch task, run by a worker thread. Its start and end times are written by the worker,
+        // and read by the main thread once the worker is joined.
+        struct PrefetchTask
+        {
+        #ifndef HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+            std::thread thread;
+        #endif
+            double startTime = -1.;
+            double endTime = -1.;
+        };
+
+        struct StartupPipelineStatics
+        {
+            // Startup being measured: only accessed by the main thread
+            StartupTimings currentStartup;
+            double lastPhaseEndTime = 0.;
+            bool isRecording = false;
+
+            PrefetchTask settingsTask;  // application settings, hello_imgui.ini files
+            PrefetchTask assetsTask;    // fonts, window icon, startupPrefetchAssets
+            double prefetchStartTime = -1.;
+
+            // Published timings (GetStartupTimings() may be called from any thread)
+            std::mutex publishedMutex;
+            StartupTimings publishedStartup;
+
+            // If Setup() was interrupted, the workers are still joinable
+            ~StartupPipelineStatics()
+            {
+            #ifndef HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+                for (PrefetchTask* task : {&settingsTask, &assetsTask})
+                    if (task->thread.joinable())
+                        task->thread.join();
+            #endif
+            }
+        };
+
+        static StartupPipelineStatics gStatics;
+
+
+        void BeginStartup()
+        {
+            double now = Internal::ClockSeconds();
+            gStatics.currentStartup = StartupTimings();
+            gStatics.currentStartup.startupStartTime = now;
+            gStatics.lastPhaseEndTime = now;
+            gStatics.isRecording = true;
+        }
+
+        void EndPhase(StartupPhase phase)
+        {
+            if (!gStatics.isRecording)
+                return;
+            double now = Internal::ClockSeconds();
+            gStatics.currentStartup.phaseDurations[(int)phase] += now - gStatics.lastPhaseEndTime;
+            gStatics.lastPhaseEndTime = now;
+        }
+
+        static void RunTask(PrefetchTask* task, const std::function<void()>& fn)
+        {
+            task->startTime = Internal::ClockSeconds();
+            fn();
+            task->endTime = Internal::ClockSeconds();
+        }
+
+        static void StartTask(PrefetchTask* task, std::function<void()> fn)
+        {
+        #ifndef HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+            try
+            {
+                task->thread = std::thread([task, fn]() { RunTask(task, fn); });
+                return;
+            }
+            catch (const std::system_error&)
+            {
+                // No thread available: run the task now, so that the pending assets are not awaited forever
+            }
+        #endif
+            RunTask(task, fn);
+        }
+
+        static void JoinTask(PrefetchTask* task)
+        {
+        #ifndef HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+            if (task->thread.joinable())
+                task->thread.join();
+        #else
+            (void)task;
+        #endif
+        }
+
+        static std::vector<std::string> AssetsToPrefetch(const RunnerParams& params)
+        {
+            std::vector<std::string> r;
+            auto defaultFontLoader = params.callbacks.LoadAdditionalFonts.target<void(*)()>();
+            if (defaultFontLoader != nullptr && *defaultFontLoader == ImGuiDefaultSettings::LoadDefaultFont_WithFontAwesomeIcons)
+                r = ImGuiDefaultSettings::DefaultFontAssetFiles(params.callbacks.defaultIconFont);
+            if (params.platformBackendType != PlatformBackendType::Null)
+                r.push_back("app_settings/icon.png");  // see Impl_SetWindowIcon()
+            for (const auto& assetPath : params.startupPrefetchAssets)
+                if (std::find(r.begin(), r.end(), assetPath) == r.end())
+                    r.push_back(assetPath);
+            return r;
+        }
+
+        void StartPrefetch(const RunnerParams& params)
+        {
+        #ifdef HELLOIMGUI_STARTUP_PREFETCH_NO_THREAD
+            (void)params;
+        #else
+            if (!params.startupPrefetch)
+                return;
+
+            // IniSettingsLocation() may create the settings folder: it is called from the main thread
+            std::string iniSettingsFile = IniSettingsLocation(params);
+            StartTask(&gStatics.settingsTask, [iniSettingsFile]()
+            {
+                HelloImGuiIniAnyParentFolder::prefetchIniFiles();
+                HelloImGuiIniSettings::LoadIniPartsCached(iniSettingsFile);
+            });
+
+            // Under Android, assets are read through SDL and the JNI: they are read by the main thread
+            #ifndef __ANDROID__
+            // The assets are registered before the worker starts, so that LoadAssetFileData waits for them
+            AssetPrefetch::MarkPending(AssetsToPrefetch(params));
+            StartTask(&gStatics.assetsTask, []() { AssetPrefetch::LoadPending(); });
+            #endif
+        #endif
+        }
+
+        void FinishPrefetch()
+        {
+            JoinTask(&gStatics.settingsTask);
+            JoinTask(&gStatics.assetsTask);
+            AssetPrefetch::Clear();
+
+            double startTime = -1., endTime = -1.;
+            for (const PrefetchTask* task : {&gStatics.settingsTask, &gStatics.assetsTask})
+            {
+                if (task->startTime < 0.)
+                    continue;
+                startTime = (startTime < 0.) ? task->startTime : std::min(startTime, task->startTime);
+                endTime = std::max(endTime, task->endTime);
+            }
+            if (startTime >= 0.)
+                gStatics.currentStartup.prefetchDuration = endTime - startTime;
+            gStatics.prefetchStartTime = startTime;
+            gStatics.settingsTask = PrefetchTask();
+            gStatics.assetsTask = PrefetchTask();
+        }
+
+        void EndStartup()
+        {
+            if (!gStatics.isRecording)
+                return;
+            gStatics.isRecording = false;
+            {
+                std::lock_guard<std::mutex> lock(gStatics.publishedMutex);
+                gStatics.publishedStartup = gStatics.currentStartup;
+            }
+
+            if (TraceExporter::IsActive())
+            {
+                const StartupTimings& startup = gStatics.currentStartup;
+                TraceExporter::AddCompleteEvent("Startup", "startup", startup.startupStartTime, startup.TotalDuration());
+                double phaseStartTime = startup.startupStartTime;
+                for (int i = 0; i < NbPhases; ++i)
+                {
+                    double duration = startup.phaseDurations[i];
+                    if (duration > 0.)
+                        TraceExporter::AddCompleteEvent(StartupPhaseName((StartupPhase)i), "startup", phaseStartTime, duration);
+                    phaseStartTime += duration;
+                }
+                if (gStatics.prefetchStartTime >= 0.)
+                    TraceExporter::AddCompleteEvent("Prefetch", "startup", gStatics.prefetchStartTime, startup.prefetchDuration);
+            }
+        }
+    }
+
+    StartupTimings GetStartupTimings()
+    {
+        std::lock_guard<std::mutex> lock(StartupPipeline::gStatics.publishedMutex);
+        return StartupPipeline::gStatics.publishedStartup;
+    }
+}
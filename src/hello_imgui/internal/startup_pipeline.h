@@ -0,0 +1,30 @@
+#pragma once
+#include "hello_imgui/hello_imgui.h"
+
+namespace HelloImGui
+{
+    // StartupPipeline measures the phases of AbstractRunner::Setup(), and prefetches the files
+    // needed during startup on worker threads (see RunnerParams.startupPrefetch),
+    // while the main thread creates the window and the rendering context.
+    //
+    // Usage inside AbstractRunner::Setup():
+    //     StartupPipeline::BeginStartup();
+    //     StartupPipeline::StartPrefetch(params);
+    //     ... (window creation)    StartupPipeline::EndPhase(StartupPhase::CreateWindow);
+    //     ...
+    //     StartupPipeline::FinishPrefetch();
+    //     StartupPipeline::EndPhase(StartupPhase::Finalize);
+    //     StartupPipeline::EndStartup();   // publishes the timings (and writes them to the trace file, if any)
+    namespace StartupPipeline
+    {
+        void BeginStartup();
+        // Stores the time elapsed since the previous phase end (or since BeginStartup) as the duration of `phase`
+        void EndPhase(StartupPhase phase);
+        void EndStartup();
+
+        // Launches the prefetch tasks (settings files, hello_imgui.ini files, assets) on worker threads
+        void StartPrefetch(const RunnerParams& params);
+        // Waits for the prefetch tasks, and frees the prefetched assets which were not used
+        void FinishPrefetch();
+    }
+}
@@ -0,0 +1,230 @@
+#include "hello_imgui/internal/trace_exporter.h"
+#include "hello_imgui/internal/clock_seconds.h"
+#include "hello_imgui/hello_imgui.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+// Under emscripten, threads are only available when built with HELLOIMGUI_EMSCRIPTEN_PTHREAD
+#if defined(__EMSCRIPTEN__) && !defined(HELLOIMGUI_EMSCRIPTEN_PTHREAD)
+#define HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+#endif
+
+#ifndef HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#endif
+
+namespace HelloImGui
+{
+    namespace TraceExporter
+    {
+        struct TraceEvent
+        {
+            std::string name;
+            const char* category; // always a string literal
+            double startTime;
+            double duration;
+            uint32_t threadId;
+        };
+
+        struct TraceExporterStatics
+        {
+            std::atomic<bool> isActive{false};
+
+            // Events waiting to be written (filled by any thread)
+            std::mutex pendingMutex;
+            std::vector<TraceEvent> pendingEvents;
+
+            // Only accessed by the flushing thread (or by Start/Stop when it is not running)
+            std::FILE* file = nullptr;
+            bool isFirstEvent = true;
+            std::vector<TraceEvent> writtenEvents;
+
+            float flushInterval = 1.f;
+            double lastFlushTime = 0.;
+
+        #ifndef HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+            std::thread flushThread;
+            std::mutex stopMutex;
+            std::condition_variable stopCondition;
+            bool stopRequested = false;
+        #endif
+        };
+
+        static TraceExporterStatics gStatics;
+
+
+        static uint32_t CurrentThreadId()
+        {
+            static std::atomic<uint32_t> sThreadCounter{0};
+            thread_local uint32_t threadId = ++sThreadCounter;
+            return threadId;
+        }
+
+        static std::string JsonEscape(const std::string& s)
+        {
+            std::string r;
+            r.reserve(s.size());
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    r += '\\';
+                    r += c;
+                }
+                else if ((unsigned char)c < 0x20)
+                {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned)c);
+                    r += buffer;
+                }
+                else
+                    r += c;
+            }
+            return r;
+        }
+
+        static void WritePendingEvents()
+        {
+            {
+                std::lock_guard<std::mutex> lock(gStatics.pendingMutex);
+                gStatics.writtenEvents.swap(gStatics.pendingEvents);
+            }
+            if (gStatics.file == nullptr)
+            {
+                gStatics.writtenEvents.clear();
+                return;
+            }
+
+            for (const auto& event : gStatics.writtenEvents)
+            {
+                fprintf(gStatics.file,
+                        "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                        gStatics.isFirstEvent ? "" : ",",
+                        JsonEscape(event.name).c_str(),
+                        event.category,
+                        event.startTime * 1e6,
+                        event.duration * 1e6,
+                        event.threadId);
+                gStatics.isFirstEvent = false;
+            }
+            fflush(gStatics.file);
+            // Keep the capacity, so that the two vectors do not reallocate once warmed up
+            gStatics.writtenEvents.clear();
+        }
+
+    #ifndef HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+        static void FlushThreadLoop()
+        {
+            auto interval = std::chrono::duration<double>(gStatics.flushInterval);
+            std::unique_lock<std::mutex> lock(gStatics.stopMutex);
+            while (!gStatics.stopRequested)
+            {
+                gStatics.stopCondition.wait_for(lock, interval, [] { return gStatics.stopRequested; });
+                lock.unlock();
+                WritePendingEvents();
+                lock.lock();
+            }
+        }
+    #endif
+
+
+        void Start(const std::string& filename, float flushIntervalSeconds)
+        {
+            if (IsActive())
+                Stop();
+
+            gStatics.file = fopen(filename.c_str(), "w");
+            if (gStatics.file == nullptr)
+            {
+                fprintf(stderr, "HelloImGui: cannot open trace export file %s\n", filename.c_str());
+                return;
+            }
+            fprintf(gStatics.file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+            gStatics.isFirstEvent = true;
+            {
+                // Events added by other threads while the previous trace was being stopped belong to no file
+                std::lock_guard<std::mutex> lock(gStatics.pendingMutex);
+                gStatics.pendingEvents.clear();
+            }
+            gStatics.flushInterval = flushIntervalSeconds > 0.f ? flushIntervalSeconds : 1.f;
+            gStatics.lastFlushTime = Internal::ClockSeconds();
+
+        #ifndef HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+            gStatics.stopRequested = false;
+            gStatics.flushThread = std::thread(FlushThreadLoop);
+        #endif
+            gStatics.isActive = true;
+        }
+
+        void Stop()
+        {
+            if (!IsActive())
+                return;
+            gStatics.isActive = false;
+
+        #ifndef HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+            {
+                std::lock_guard<std::mutex> lock(gStatics.stopMutex);
+                gStatics.stopRequested = true;
+            }
+            gStatics.stopCondition.notify_one();
+            if (gStatics.flushThread.joinable())
+                gStatics.flushThread.join();
+        #endif
+
+            WritePendingEvents();
+            fprintf(gStatics.file, "\n]}\n");
+            fclose(gStatics.file);
+            gStatics.file = nullptr;
+        }
+
+        bool IsActive()
+        {
+            return gStatics.isActive.load(std::memory_order_relaxed);
+        }
+
+        void AddCompleteEvent(const char* name, const char* category, double startTime, double duration)
+        {
+            if (!IsActive())
+                return;
+            uint32_t threadId = CurrentThreadId();
+            std::lock_guard<std::mutex> lock(gStatics.pendingMutex);
+            gStatics.pendingEvents.push_back(TraceEvent{name, category, startTime, duration, threadId});
+        }
+
+        void FlushIfNoBackgroundThread()
+        {
+        #ifdef HELLOIMGUI_TRACE_EXPORTER_NO_THREAD
+            if (!IsActive())
+                return;
+            double now = Internal::ClockSeconds();
+            if (now - gStatics.lastFlushTime >= (double)gStatics.flushInterval)
+            {
+                WritePendingEvents();
+                gStatics.lastFlushTime = now;
+            }
+        #endif
+        }
+    }
+
+
+    ProfileScope::ProfileScope(const char* name)
+        : mName(name)
+        , mStartTime(TraceExporter::IsActive() ? Internal::ClockSeconds() : -1.)
+    {
+    }
+
+    ProfileScope::~ProfileScope()
+    {
+        if (mStartTime < 0. || !TraceExporter::IsActive())
+            return;
+        double now = Internal::ClockSeconds();
+        TraceExporter::AddCompleteEvent(mName, "scope", mStartTime, now - mStartTime);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+
+namespace HelloImGui
+{
+    // TraceExporter streams timing events into a Chrome Trace Event JSON file
+    // (https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU)
+    //
+    // Producers (the main loop, and ProfileScope from any thread) only append events to a pending queue;
+    // a background thread periodically swaps this queue and writes it to disk.
+    namespace TraceExporter
+    {
+        void Start(const std::string& filename, float flushIntervalSeconds);
+        // Writes the remaining events, closes the file, and stops the background thread
+        void Stop();
+        bool IsActive();
+
+        // Adds a "complete" event (ph="X"). Times are in seconds (see Internal::ClockSeconds())
+        void AddCompleteEvent(const char* name, const char* category, double startTime, double duration);
+
+        // Under emscripten without pthreads, there is no background thread:
+        // the main loop shall call this once per frame, and it will flush when needed.
+        void FlushIfNoBackgroundThread();
+    }
+}
@@ -0,0 +1,76 @@
+#include "hello_imgui/internal/view_menu_model.h"
+#include "hello_imgui/docking_params.h"
+
+#include <algorithm>
+
+
+namespace HelloImGui
+{
+    // FNV-1a
+    static uint64_t HashBytes(uint64_t h, const void* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= (uint64_t)bytes[i];
+            h *= 0x100000001B3ull;
+        }
+        return h;
+    }
+
+    static uint64_t HashString(uint64_t h, const std::string& s)
+    {
+        size_t size = s.size();
+        h = HashBytes(h, &size, sizeof(size));
+        return HashBytes(h, s.data(), s.size());
+    }
+
+    uint64_t ViewMenuFingerprint(const std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
+    {
+        uint64_t h = 0xCBF29CE484222325ull;
+        for (const auto& dockableWindow : dockableWindows)
+        {
+            const DockableWindow* ptr = dockableWindow.get();
+            h = HashBytes(h, &ptr, sizeof(ptr));
+            if (ptr == nullptr)
+                continue;
+            h = HashString(h, ptr->label);
+            h = HashString(h, ptr->category);
+            unsigned char includeInViewMenu = ptr->includeInViewMenu ? 1 : 0;
+            h = HashBytes(h, &includeInViewMenu, 1);
+        }
+        return h;
+    }
+
+    bool ViewMenuModel::Update(const std::vector<std::shared_ptr<DockableWindow>>& dockableWindows)
+    {
+        uint64_t newFingerprint = ViewMenuFingerprint(dockableWindows);
+        if (isBuilt && newFingerprint == fingerprint)
+            return false;
+        fingerprint = newFingerprint;
+        isBuilt = true;
+
+        std::vector<std::shared_ptr<DockableWindow>> sortedByLabel;
+        for (const auto& dockableWindow : dockableWindows)
+            if (dockableWindow != nullptr && dockableWindow->includeInViewMenu)
+                sortedByLabel.push_back(dockableWindow);
+        std::sort(sortedByLabel.begin(), sortedByLabel.end(),
+                  [](auto const& a, auto const& b) { return a->label < b->label; });
+
+        std::vector<std::shared_ptr<DockableWindow>> sortedByCategory = sortedByLabel;
+        std::stable_sort(sortedByCategory.begin(), sortedByCategory.end(),
+                         [](auto const& a, auto const& b) { return a->category < b->category; });
+
+        windowsByLabel.assign(sortedByLabel.begin(), sortedByLabel.end());
+        windowsByCategory.assign(sortedByCategory.begin(), sortedByCategory.end());
+        categoryGroups.clear();
+        for (size_t i = 0; i < sortedByCategory.size(); ++i)
+        {
+            const std::string& category = sortedByCategory[i]->category;
+            if (categoryGroups.empty() || categoryGroups.back().category != category)
+                categoryGroups.push_back({category, i, i});
+            categoryGroups.back().end = i + 1;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace HelloImGui
+{
+    struct DockableWindow;
+
+    // ViewMenuModel: the dockable windows of a dockableWindows vector, as displayed by the View menu
+    // (sorted by label, and grouped by category). It is rebuilt only when the windows are added, removed,
+    // renamed, recategorized or hidden from the menu, so that displaying the menu does not allocate.
+    // The model does not own the windows: a removed window is destroyed, even if the menu is not displayed.
+    struct ViewMenuModel
+    {
+        struct CategoryGroup
+        {
+            std::string category;
+            size_t begin = 0, end = 0;  // range inside windowsByCategory
+        };
+
+        uint64_t fingerprint = 0;
+        bool isBuilt = false;
+        int lastUsedFrame = -1;  // models of the vectors which were not displayed are forgotten
+        std::vector<std::weak_ptr<DockableWindow>> windowsByLabel;
+        std::vector<std::weak_ptr<DockableWindow>> windowsByCategory;  // sorted by category, then label
+        std::vector<CategoryGroup> categoryGroups;
+
+        // Returns true if the model was rebuilt
+        bool Update(const std::vector<std::shared_ptr<DockableWindow>>& dockableWindows);
+    };
+
+    // Hash of the windows, of their label and category, and of includeInViewMenu (does not allocate)
+    uint64_t ViewMenuFingerprint(const std::vector<std::shared_ptr<DockableWindow>>& dockableWindows);
+}
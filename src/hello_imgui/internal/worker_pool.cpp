@@ -0,0 +1,85 @@
+#include "hello_imgui/internal/worker_pool.h"
+
+#include <algorithm>
+#include <deque>
+
+// Under emscripten, threads are only available when built with HELLOIMGUI_EMSCRIPTEN_PTHREAD
+#if defined(__EMSCRIPTEN__) && !defined(HELLOIMGUI_EMSCRIPTEN_PTHREAD)
+#define HELLOIMGUI_WORKER_POOL_NO_THREAD
+#endif
+
+#ifndef HELLOIMGUI_WORKER_POOL_NO_THREAD
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace HelloImGui
+{
+#ifndef HELLOIMGUI_WORKER_POOL_NO_THREAD
+    struct WorkerPool::Impl
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::function<void()>> jobs;
+        bool stopRequested = false;
+        std::vector<std::thread> threads;
+
+        void ThreadLoop()
+        {
+            while (true)
+            {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [this] { return stopRequested || !jobs.empty(); });
+                    if (stopRequested)
+                        return;
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                job();
+            }
+        }
+    };
+
+    WorkerPool::WorkerPool(int nbThreads)
+        : mImpl(std::make_unique<Impl>())
+    {
+        nbThreads = std::max(nbThreads, 1);
+        for (int i = 0; i < nbThreads; ++i)
+            mImpl->threads.emplace_back([this] { mImpl->ThreadLoop(); });
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mImpl->mutex);
+            mImpl->stopRequested = true;
+            mImpl->jobs.clear();
+        }
+        mImpl->condition.notify_all();
+        for (auto& thread : mImpl->threads)
+            thread.join();
+    }
+
+    void WorkerPool::Submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mImpl->mutex);
+            mImpl->jobs.push_back(std::move(job));
+        }
+        mImpl->condition.notify_one();
+    }
+
+#else // HELLOIMGUI_WORKER_POOL_NO_THREAD
+
+    struct WorkerPool::Impl {};
+
+    WorkerPool::WorkerPool(int) : mImpl(std::make_unique<Impl>()) {}
+    WorkerPool::~WorkerPool() = default;
+    void WorkerPool::Submit(std::function<void()> job) { job(); }
+
+#endif
+}
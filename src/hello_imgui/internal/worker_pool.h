@@ -0,0 +1,24 @@
+#pragma once
+#include <functional>
+#include <memory>
+
+namespace HelloImGui
+{
+    // A minimal fixed-size thread pool.
+    // Jobs are run in submission order; the destructor waits for the running jobs and drops the pending ones.
+    // (Under emscripten without pthreads, jobs are run synchronously inside Submit())
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(int nbThreads);
+        ~WorkerPool();
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        void Submit(std::function<void()> job);
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> mImpl;
+    };
+}
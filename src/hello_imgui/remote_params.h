@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <cstdint>
 
 
@@ -9,6 +10,18 @@ namespace HelloImGui
 
 // @@md#RemoteParams
 
+// WsControlMode: how the imgui-ws clients share the control of the application
+// (all the clients see the same draw data, but only one of them may send inputs at a given time)
+// - RoundRobin: the control goes from one client to the next every wsControlDurationSeconds
+// - Operator: one client is the operator (see RemoteParams.wsOperatorIps), and the others are passive viewers,
+//   whose inputs are ignored. When the operator disconnects, the control goes to the next eligible client.
+enum class WsControlMode
+{
+    RoundRobin,
+    Operator,
+};
+
+
 // RemoteParams is a struct that contains the settings for displaying the application on a remote device.
 // using https://github.com/sammyfreg/netImgui
 // or using https://github.com/ggerganov/imgui-ws
@@ -17,12 +30,31 @@ struct RemoteParams
 {
     bool enableRemoting = false;
 
+    // The app produces frames at the rate its remote viewers are configured to poll them
+    // (with imgui-ws and the provided index.html: every wsUpdateFreqMs; otherwise fpsRemoteMax),
+    // within [fpsRemoteMin, fpsRemoteMax]. This rate is not measured, and does not adapt to a slow link.
+    // When no viewer is connected, it only produces fpsNoViewer frames per second
+    // (at least 0.5: a new viewer is detected at the next frame).
+    float fpsRemoteMax = 60.f;
+    float fpsRemoteMin = 10.f;
+    float fpsNoViewer = 2.f;
+
     //
     // Params used only by imgui-ws
     //
     int wsPort = 5003;
     std::string wsHttpRootFolder = "";  // Optional folder were some additional files can be served
     bool wsProvideIndexHtml = true;     // If true, will automatically serve a simple index.html file that contains the canvas and the imgui-ws client code
+    int wsUpdateFreqMs = 16;            // Interval at which the provided index.html polls the draw data (between 16 and 200ms)
+    // If true, the draw data is only transmitted when at least one draw list changed
+    // (each draw list is hashed after every frame). Clients keep displaying the previous draw data otherwise.
+    // Experimental: disabled by default.
+    bool wsSkipUnchangedDrawData = false;
+    WsControlMode wsControlMode = WsControlMode::RoundRobin;
+    float wsControlDurationSeconds = 10.f;  // Used only in RoundRobin mode
+    // Used only in Operator mode: IP addresses of the clients that may become operator.
+    // If empty, any client may: the client connected for the longest time is the operator.
+    std::vector<std::string> wsOperatorIps;
 
     //
     // Params used only by netImgui
@@ -36,6 +68,11 @@ struct RemoteParams
     uint32_t serverPort = 8888;
     // If true, transmit the window size to the server
     bool transmitWindowSize = false;
+    // Connection and reconnections are handled in a background thread:
+    // after a failed tentative, it waits reconnectDelayMin seconds, then doubles this delay
+    // after each new failure (up to reconnectDelayMax seconds)
+    double reconnectDelayMin = 0.25;
+    double reconnectDelayMax = 4.0;
 };
 
 // @@md
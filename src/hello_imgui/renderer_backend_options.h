@@ -87,6 +87,26 @@ struct RendererBackendOptions
     // Before setting this to true, first check `hasEdrSupport()`
     bool requestFloatBuffer = false;
 
+    // `nullBackendSoftwareRasterizer`:
+    // When using the Null rendering backend (headless runs, e.g. on a CI machine without GPU),
+    // set this to true so that ImGui's draw data is rendered by a multithreaded CPU rasterizer
+    // (using at most 4 worker threads), and AppWindowScreenshotRgbBuffer() returns real pixels.
+    // By default, the Null backend skips rendering entirely.
+    // (This rasterizer is never used when displaying remotely)
+    bool nullBackendSoftwareRasterizer = false;
+
+    // `skipUnchangedFrames`:
+    // If true, a hash of ImGui's draw data is computed at each frame, and when it is identical
+    // to the previous frame, the rendering of the draw data and the buffer swap are skipped
+    // (the GUI logic still runs, and the loop waits for the rest of the monitor refresh period instead of the swap).
+    // This reduces the GPU, compositor and power usage when the GUI is static
+    // (e.g. a dashboard, while the mouse moves outside the window).
+    // Only enable this if the window content depends only on ImGui's draw data:
+    //   - it is disabled when callbacks.CustomBackground is set
+    //   - frames with draw callbacks or pending texture updates are always rendered
+    //   - textures whose content you update in place (e.g. a video) would not be refreshed!
+    bool skipUnchangedFrames = false;
+
     // `openGlOptions`:
     // Advanced options for OpenGL. Use at your own risk.
     OpenGlOptions openGlOptions;
@@ -7,6 +7,7 @@
 #include "hello_imgui/remote_params.h"
 #include "hello_imgui/renderer_backend_options.h"
 #include "hello_imgui/dpi_aware.h"
+#include "hello_imgui/image_from_asset.h"
 #include <vector>
 
 namespace HelloImGui
@@ -138,6 +139,9 @@ struct FpsIdling
 
     // `timeActiveAfterLastEvent`: _float, default=3.f_.
     //  Time in seconds after the last event before the application is considered idling.
+    //  If your animated widgets call HelloImGui::RequestAnimationFrames(), they will keep
+    //  their frame rate while idling, and you may reduce this value (e.g. to 0.2 second),
+    //  so that a static GUI drops to fpsIdle almost immediately after the last user input.
     float timeActiveAfterLastEvent = 3.f;
 
     // `enableIdling`: _bool, default=true_.
@@ -269,6 +273,65 @@ struct RunnerParams
     // If it fails, look at DpiAwareParams (and the corresponding Ini file settings)
     DpiAwareParams dpiAwareParams;
 
+    // --------------- Images -------------------
+
+    // `imageFromAssetParams`: _see image_from_asset.h_
+    // Options for the loading of images via ImageFromAsset (async loading, etc.)
+    ImageFromAssetParams imageFromAssetParams;
+
+    // --------------- Profiling -------------------
+
+    // `enableFrameProfiler`: _bool, default=false_.
+    // If true, the duration of each phase of each frame (layout, idling, events,
+    // NewFrame, Gui, rendering & swap, AfterSwap) is recorded, and can be queried
+    // via HelloImGui::FramePhaseTimingsHistory().
+    // Set imGuiWindowParams.showStatus_FrameProfiler to display it in the status bar.
+    bool enableFrameProfiler = false;
+
+    // `traceExportFile`: _string, default=""_.
+    // If not empty, the frame phases and the HelloImGui::ProfileScope markers are streamed
+    // into this file, using the Chrome Trace Event JSON format
+    // (open it with about://tracing in Chrome, or with https://ui.perfetto.dev).
+    // The file is written by a background thread, every `traceExportFlushInterval` seconds.
+    std::string traceExportFile = "";
+    // `traceExportFlushInterval`: _float, default=1_. Interval in seconds between two writes to traceExportFile
+    float traceExportFlushInterval = 1.f;
+
+    // --------------- Startup -------------------
+
+    // `startupPrefetch`: _bool, default=true_.
+    // If true, the files needed during startup are read by worker threads while the platform
+    // window and the rendering context are being created: the application settings, the
+    // hello_imgui.ini files of the current folder and its parents, the default fonts, the window icon,
+    // and startupPrefetchAssets.
+    // The assets are searched in the assets folder set before HelloImGui::Run(): if SetAssetsFolder()
+    // is called later (e.g. in PostInit), the prefetched assets are not used.
+    // The duration of each startup phase can be queried via HelloImGui::GetStartupTimings().
+    bool startupPrefetch = true;
+    // `startupPrefetchAssets`: _vector<string>, default=empty_.
+    // Additional assets to prefetch during startup (e.g. the fonts loaded by your LoadAdditionalFonts callback).
+    // A prefetched asset is returned by the next call to LoadAssetFileData() with the same path.
+    std::vector<std::string> startupPrefetchAssets;
+
+    // --------------- Input recording & replay -------------------
+
+    // `inputRecordFile`: _string, default=""_.
+    // If not empty, all the input events received by ImGui (mouse, keyboard, text, focus),
+    // together with the display size and io.DeltaTime of each frame, are recorded and
+    // written into this binary file when the application exits.
+    std::string inputRecordFile = "";
+    // `inputReplayFile`: _string, default=""_.
+    // If not empty, the inputs recorded in this file (see inputRecordFile) are fed
+    // into ImGui, one recorded frame per rendered frame, and the application exits
+    // after the last recorded frame (idling is disabled during the replay).
+    // Use it with the Null platform backend (PlatformBackendType::Null), so that a session
+    // recorded once can be replayed headless and reproducibly
+    // (e.g. to compare the frame times of several builds).
+    std::string inputReplayFile = "";
+    // `inputReplayFixedTimestep`: _float, default=1/60_.
+    // io.DeltaTime used during a replay. If <= 0, the recorded io.DeltaTime values are used.
+    float inputReplayFixedTimestep = 1.f / 60.f;
+
     // --------------- Misc -------------------
 
     // `useImGuiTestEngine`: _bool, default=false_.
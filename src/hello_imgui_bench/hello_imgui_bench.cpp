@@ -0,0 +1,498 @@
+// hello_imgui_bench: headless benchmarks of HelloImGui, for CI machines without GPU.
+//
+// Each workload runs RunnerNull (+ the Null rendering backend, i.e. the software rasterizer)
+// through ManualRender::Render() for a given number of frames, and reports as JSON:
+//     - the per-frame wall time and process CPU time
+//     - the number of allocations (and allocated bytes) per frame
+//     - the draw data payload per frame that a remote display (imgui-ws) would transmit:
+//       in full every frame, or only for frames where at least one draw list changed
+//       (see RemoteParams.wsSkipUnchangedDrawData)
+//     - the peak resident set size of the process (which is cumulative across workloads:
+//       run a single workload with --workload to isolate it)
+//
+// Usage:
+//     hello_imgui_bench [--frames N] [--warmup N] [--workload name]... [--no-raster] [--output report.json]
+//     hello_imgui_bench --list
+#include "hello_imgui/hello_imgui.h"
+#include "hello_imgui/internal/draw_data_hash.h"
+#include "nlohmann/json.hpp"
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+// =====================================================================================================================
+// Allocation counting (C++ allocations via operator new, and ImGui allocations via its allocator functions)
+// =====================================================================================================================
+static std::atomic<uint64_t> gNbAllocations(0);
+static std::atomic<uint64_t> gAllocatedBytes(0);
+
+static void* CountedMalloc(size_t size)
+{
+    gNbAllocations.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return malloc(size);
+}
+
+void* operator new(size_t size)
+{
+    void* p = CountedMalloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedMalloc(size == 0 ? 1 : size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedMalloc(size == 0 ? 1 : size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+static void* ImGuiCountedAlloc(size_t size, void*) { return CountedMalloc(size); }
+static void ImGuiCountedFree(void* p, void*) { free(p); }
+
+
+static uint64_t PeakRssBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return (uint64_t)counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    #if defined(__APPLE__)
+        return (uint64_t)usage.ru_maxrss;          // bytes
+    #else
+        return (uint64_t)usage.ru_maxrss * 1024;   // kilobytes
+    #endif
+#endif
+}
+
+
+// =====================================================================================================================
+// Synthetic icons: "bench_icons/icon_NNN.png" assets are generated in memory
+// =====================================================================================================================
+static const char* kIconsFolder = "bench_icons/";
+static constexpr int kNbIcons = 256;
+static constexpr int kIconSize = 32;
+
+static std::string IconAssetPath(int idx)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "%sicon_%03d.png", kIconsFolder, idx);
+    return path;
+}
+
+static std::vector<unsigned char> MakeIconPng(int idx)
+{
+    // A disc, whose color depends on the icon index, on a transparent background
+    std::vector<unsigned char> rgba(kIconSize * kIconSize * 4);
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB((float)idx / (float)kNbIcons, 0.7f, 0.9f, r, g, b);
+    for (int y = 0; y < kIconSize; ++y)
+        for (int x = 0; x < kIconSize; ++x)
+        {
+            float dx = (float)x + 0.5f - kIconSize / 2.f, dy = (float)y + 0.5f - kIconSize / 2.f;
+            float alpha = std::clamp(kIconSize / 2.f - std::sqrt(dx * dx + dy * dy), 0.f, 1.f);
+            unsigned char* pixel = &rgba[(y * kIconSize + x) * 4];
+            pixel[0] = (unsigned char)(r * 255.f);
+            pixel[1] = (unsigned char)(g * 255.f);
+            pixel[2] = (unsigned char)(b * 255.f);
+            pixel[3] = (unsigned char)(alpha * 255.f);
+        }
+
+    std::vector<unsigned char> png;
+    auto fnAppend = [](void* context, void* data, int size)
+    {
+        auto* out = (std::vector<unsigned char>*)context;
+        out->insert(out->end(), (unsigned char*)data, (unsigned char*)data + size);
+    };
+    stbi_write_png_to_func(fnAppend, &png, kIconSize, kIconSize, 4, rgba.data(), kIconSize * 4);
+    return png;
+}
+
+static HelloImGui::AssetFileData LoadBenchAsset(const char* assetPath)
+{
+    size_t folderLength = strlen(kIconsFolder);
+    if (strncmp(assetPath, kIconsFolder, folderLength) != 0)
+        return HelloImGui::DefaultLoadAssetFileData(assetPath);
+
+    int idx = atoi(assetPath + folderLength + strlen("icon_"));
+    std::vector<unsigned char> png = MakeIconPng(idx);
+    HelloImGui::AssetFileData r;
+    r.data = malloc(png.size()); // freed by FreeAssetFileData
+    memcpy(r.data, png.data(), png.size());
+    r.dataSize = png.size();
+    return r;
+}
+
+
+// =====================================================================================================================
+// Workloads
+// =====================================================================================================================
+struct BenchOptions
+{
+    int nbFrames = 300;
+    int nbWarmupFrames = 10;
+    bool useRasterizer = true;
+    std::vector<std::string> workloadNames; // all workloads if empty
+    std::string outputFile;                 // stdout if empty
+};
+
+struct Workload
+{
+    std::string name;
+    std::string description;
+    std::function<void(HelloImGui::RunnerParams&)> fnSetup;
+};
+
+static HelloImGui::RunnerParams MakeBaseRunnerParams(const BenchOptions& options)
+{
+    HelloImGui::RunnerParams params;
+    params.platformBackendType = HelloImGui::PlatformBackendType::Null;
+    params.rendererBackendType = HelloImGui::RendererBackendType::Null;
+    params.rendererBackendOptions.nullBackendSoftwareRasterizer = options.useRasterizer;
+    params.appWindowParams.windowTitle = "hello_imgui_bench";
+    params.iniFolderType = HelloImGui::IniFolderType::TempFolder;
+    params.iniFilename = "hello_imgui_bench/hello_imgui_bench.ini";
+    params.fpsIdling.enableIdling = false;
+    params.imGuiWindowParams.defaultImGuiWindowType = HelloImGui::DefaultImGuiWindowType::ProvideFullScreenDockSpace;
+    params.imGuiWindowParams.showMenuBar = true;
+    params.imGuiWindowParams.showStatusBar = true;
+    params.dockingParams.layoutCondition = HelloImGui::DockingLayoutCondition::ApplicationStart;
+    return params;
+}
+
+static void WidgetsGui(int idx)
+{
+    static float values[4] = {0.f, 0.f, 0.f, 0.f};
+    ImGui::Text("Window %d", idx);
+    ImGui::SliderFloat("Value", &values[idx % 4], 0.f, 1.f);
+    ImGui::Button("Button");
+    ImGui::SameLine();
+    ImGui::TextDisabled("(%d)", idx * 17 % 1000);
+}
+
+// nbWindows dockable windows, grouped by 10 inside group windows that have their own nested DockingParams
+static HelloImGui::DockingParams MakeDockingLayout(int nbWindows, const std::string& layoutName, bool useSplits)
+{
+    HelloImGui::DockingParams dockingParams;
+    dockingParams.layoutName = layoutName;
+    if (useSplits)
+        dockingParams.dockingSplits = {
+            { "MainDockSpace", "LeftSpace", ImGuiDir_Left, 0.25f },
+            { "MainDockSpace", "BottomSpace", ImGuiDir_Down, 0.3f },
+            { "MainDockSpace", "RightSpace", ImGuiDir_Right, 0.3f },
+        };
+    const char* spaces[] = { "MainDockSpace", "LeftSpace", "BottomSpace", "RightSpace" };
+
+    const int nbWindowsPerGroup = 10;
+    for (int idxGroup = 0; idxGroup * nbWindowsPerGroup < nbWindows; ++idxGroup)
+    {
+        auto group = std::make_shared<HelloImGui::DockableWindow>();
+        group->label = "Group " + std::to_string(idxGroup);
+        group->dockSpaceName = useSplits ? spaces[idxGroup % 4] : "MainDockSpace";
+        group->dockingParams.mainDockSpaceNodeFlags = ImGuiDockNodeFlags_None;
+        group->dockingParams.dockingSplits = { { group->label, group->label + " Top", ImGuiDir_Up, 0.5f } };
+        for (int i = 0; i < nbWindowsPerGroup && idxGroup * nbWindowsPerGroup + i < nbWindows; ++i)
+        {
+            int idxWindow = idxGroup * nbWindowsPerGroup + i;
+            auto window = std::make_shared<HelloImGui::DockableWindow>();
+            window->label = "Window " + std::to_string(idxWindow);
+            window->dockSpaceName = (i % 2 == 0) ? group->label + " Top" : group->label;
+            window->GuiFunction = [idxWindow] { WidgetsGui(idxWindow); };
+            group->dockingParams.dockableWindows.push_back(window);
+        }
+        dockingParams.dockableWindows.push_back(group);
+    }
+    return dockingParams;
+}
+
+static std::vector<Workload> MakeWorkloads()
+{
+    std::vector<Workload> workloads;
+
+    for (int nbWindows : { 10, 100, 1000 })
+        workloads.push_back({
+            "docking_" + std::to_string(nbWindows),
+            std::to_string(nbWindows) + " dockable windows, inside group windows with nested DockingParams",
+            [nbWindows](HelloImGui::RunnerParams& params) {
+                params.dockingParams = MakeDockingLayout(nbWindows, "Default", true);
+            }
+        });
+
+    workloads.push_back({
+        "log_full",
+        "Full log buffer displayed by LogGui, with 50 new lines per frame",
+        [](HelloImGui::RunnerParams& params) {
+            auto logWindow = std::make_shared<HelloImGui::DockableWindow>();
+            logWindow->label = "Logs";
+            logWindow->dockSpaceName = "MainDockSpace";
+            logWindow->GuiFunction = [] { HelloImGui::LogGui(); };
+            params.dockingParams.dockableWindows = { logWindow };
+            params.callbacks.PostInit = [] {
+                for (int i = 0; i < 20000; ++i)
+                    HelloImGui::Log(HelloImGui::LogLevel::Info, "Initial line %d: the quick brown fox jumps over the lazy dog", i);
+            };
+            params.callbacks.PreNewFrame = [] {
+                static int idxLine = 0;
+                for (int i = 0; i < 50; ++i, ++idxLine)
+                    HelloImGui::Log((HelloImGui::LogLevel)(idxLine % 4), "Line %d: the quick brown fox jumps over the lazy dog", idxLine);
+            };
+        }
+    });
+
+    for (bool useAtlas : { false, true })
+        workloads.push_back({
+            useAtlas ? "icons_atlas" : "icons",
+            std::string("512 ImageFromAsset icons (256 distinct images)") + (useAtlas ? ", packed in an atlas" : ""),
+            [useAtlas](HelloImGui::RunnerParams& params) {
+                params.imageFromAssetParams.atlasEnabled = useAtlas;
+                auto iconsWindow = std::make_shared<HelloImGui::DockableWindow>();
+                iconsWindow->label = "Icons";
+                iconsWindow->dockSpaceName = "MainDockSpace";
+                iconsWindow->GuiFunction = [] {
+                    for (int i = 0; i < kNbIcons * 2; ++i)
+                    {
+                        HelloImGui::ImageFromAsset(IconAssetPath(i % kNbIcons).c_str(), ImVec2(24.f, 24.f));
+                        if ((i + 1) % 32 != 0)
+                            ImGui::SameLine();
+                    }
+                };
+                params.dockingParams.dockableWindows = { iconsWindow };
+            }
+        });
+
+    workloads.push_back({
+        "theme_switch",
+        "100 dockable windows, with a theme switch at each frame",
+        [](HelloImGui::RunnerParams& params) {
+            params.dockingParams = MakeDockingLayout(100, "Default", true);
+            params.callbacks.PreNewFrame = [] {
+                static int idxTheme = 0;
+                idxTheme = (idxTheme + 1) % ImGuiTheme::ImGuiTheme_Count;
+                ImGuiTheme::ApplyTheme((ImGuiTheme::ImGuiTheme_)idxTheme);
+            };
+        }
+    });
+
+    workloads.push_back({
+        "layout_switch",
+        "100 dockable windows, with a layout switch every 10 frames",
+        [](HelloImGui::RunnerParams& params) {
+            params.dockingParams = MakeDockingLayout(100, "Default", true);
+            params.alternativeDockingLayouts = { MakeDockingLayout(100, "Tabs", false) };
+            params.callbacks.PreNewFrame = [] {
+                static int idxFrame = 0;
+                if (++idxFrame % 10 == 0)
+                    HelloImGui::SwitchLayout(HelloImGui::CurrentLayoutName() == "Default" ? "Tabs" : "Default");
+            };
+        }
+    });
+
+    return workloads;
+}
+
+
+// =====================================================================================================================
+// Measures
+// =====================================================================================================================
+struct FrameMeasure
+{
+    double wallTimeMs = 0.;
+    double cpuTimeMs = 0.;
+    uint64_t nbAllocations = 0;
+    uint64_t allocatedBytes = 0;
+    size_t remoteFullBytes = 0;
+    size_t remoteSkipUnchangedBytes = 0;
+};
+
+static nlohmann::json StatsToJson(std::vector<double> values)
+{
+    if (values.empty())
+        return nlohmann::json::object();
+    std::sort(values.begin(), values.end());
+    auto fnPercentile = [&values](double p) {
+        size_t idx = (size_t)std::ceil(p * (double)values.size()) - 1;
+        return values[std::min(idx, values.size() - 1)];
+    };
+    double sum = 0.;
+    for (double v : values)
+        sum += v;
+    return {
+        { "mean", sum / (double)values.size() },
+        { "p50", fnPercentile(0.50) },
+        { "p95", fnPercentile(0.95) },
+        { "p99", fnPercentile(0.99) },
+        { "max", values.back() },
+    };
+}
+
+static nlohmann::json RunWorkload(const Workload& workload, const BenchOptions& options)
+{
+    HelloImGui::RunnerParams params = MakeBaseRunnerParams(options);
+    workload.fnSetup(params);
+
+    HelloImGui::ManualRender::SetupFromRunnerParams(params);
+    for (int i = 0; i < options.nbWarmupFrames; ++i)
+        HelloImGui::ManualRender::Render();
+
+    HelloImGui::DrawListsDeltaTracker drawListsDeltaTracker;
+    std::vector<FrameMeasure> measures(options.nbFrames);
+    for (auto& measure : measures)
+    {
+        uint64_t nbAllocationsBefore = gNbAllocations.load(), allocatedBytesBefore = gAllocatedBytes.load();
+        std::clock_t cpuBefore = std::clock();
+        auto wallBefore = std::chrono::steady_clock::now();
+
+        HelloImGui::ManualRender::Render();
+
+        auto wallAfter = std::chrono::steady_clock::now();
+        std::clock_t cpuAfter = std::clock();
+        measure.wallTimeMs = std::chrono::duration<double, std::milli>(wallAfter - wallBefore).count();
+        measure.cpuTimeMs = 1000. * (double)(cpuAfter - cpuBefore) / (double)CLOCKS_PER_SEC;
+        measure.nbAllocations = gNbAllocations.load() - nbAllocationsBefore;
+        measure.allocatedBytes = gAllocatedBytes.load() - allocatedBytesBefore;
+
+        // Outside of the timed section
+        HelloImGui::DrawListsDelta delta = drawListsDeltaTracker.Update(ImGui::GetDrawData());
+        measure.remoteFullBytes = delta.totalBytes;
+        measure.remoteSkipUnchangedBytes = delta.HasChanges() ? delta.totalBytes : 0;
+    }
+    HelloImGui::ManualRender::TearDown();
+
+    std::vector<double> wallTimes, cpuTimes, nbAllocations, allocatedBytes;
+    std::vector<double> remoteFullBytes, remoteSkipUnchangedBytes;
+    for (const auto& measure : measures)
+    {
+        wallTimes.push_back(measure.wallTimeMs);
+        cpuTimes.push_back(measure.cpuTimeMs);
+        nbAllocations.push_back((double)measure.nbAllocations);
+        allocatedBytes.push_back((double)measure.allocatedBytes);
+        remoteFullBytes.push_back((double)measure.remoteFullBytes);
+        remoteSkipUnchangedBytes.push_back((double)measure.remoteSkipUnchangedBytes);
+    }
+    return {
+        { "name", workload.name },
+        { "description", workload.description },
+        { "nbFrames", options.nbFrames },
+        { "frameWallTimeMs", StatsToJson(wallTimes) },
+        { "frameCpuTimeMs", StatsToJson(cpuTimes) },
+        { "allocationsPerFrame", StatsToJson(nbAllocations) },
+        { "allocatedBytesPerFrame", StatsToJson(allocatedBytes) },
+        { "remoteFullBytesPerFrame", StatsToJson(remoteFullBytes) },
+        { "remoteSkipUnchangedBytesPerFrame", StatsToJson(remoteSkipUnchangedBytes) },
+        { "peakRssBytes", PeakRssBytes() },
+    };
+}
+
+
+// =====================================================================================================================
+// main
+// =====================================================================================================================
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: hello_imgui_bench [--frames N] [--warmup N] [--workload name]... [--no-raster] [--output report.json]\n"
+        "       hello_imgui_bench --list\n");
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    std::vector<Workload> workloads = MakeWorkloads();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--frames" && hasValue)
+            options.nbFrames = std::max(atoi(argv[++i]), 1);
+        else if (arg == "--warmup" && hasValue)
+            options.nbWarmupFrames = std::max(atoi(argv[++i]), 0);
+        else if (arg == "--workload" && hasValue)
+            options.workloadNames.push_back(argv[++i]);
+        else if (arg == "--output" && hasValue)
+            options.outputFile = argv[++i];
+        else if (arg == "--no-raster")
+            options.useRasterizer = false;
+        else if (arg == "--list")
+        {
+            for (const auto& workload : workloads)
+                printf("%-16s %s\n", workload.name.c_str(), workload.description.c_str());
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    for (const auto& name : options.workloadNames)
+    {
+        bool exists = std::any_of(workloads.begin(), workloads.end(), [&name](const Workload& w) { return w.name == name; });
+        if (!exists)
+        {
+            fprintf(stderr, "Unknown workload: %s (use --list)\n", name.c_str());
+            return 1;
+        }
+    }
+
+    ImGui::SetAllocatorFunctions(ImGuiCountedAlloc, ImGuiCountedFree);
+    HelloImGui::SetLoadAssetFileDataFunction(LoadBenchAsset);
+
+    nlohmann::json results = nlohmann::json::array();
+    for (const auto& workload : workloads)
+    {
+        bool selected = options.workloadNames.empty()
+            || std::find(options.workloadNames.begin(), options.workloadNames.end(), workload.name) != options.workloadNames.end();
+        if (!selected)
+            continue;
+        fprintf(stderr, "hello_imgui_bench: running %s\n", workload.name.c_str());
+        results.push_back(RunWorkload(workload, options));
+    }
+
+    nlohmann::json report = {
+        { "benchmark", "hello_imgui_bench" },
+        { "rasterizer", options.useRasterizer },
+        { "nbWarmupFrames", options.nbWarmupFrames },
+        { "workloads", results },
+    };
+    if (options.outputFile.empty())
+        std::cout << report.dump(2) << std::endl;
+    else
+    {
+        std::ofstream file(options.outputFile);
+        if (!file)
+        {
+            fprintf(stderr, "Cannot write %s\n", options.outputFile.c_str());
+            return 1;
+        }
+        file << report.dump(2) << std::endl;
+    }
+    return 0;
+}
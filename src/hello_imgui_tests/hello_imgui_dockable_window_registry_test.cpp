@@ -0,0 +1,62 @@
+#include "doctest.h"
+#include "hello_imgui/internal/dockable_window_registry.h"
+#include "hello_imgui/docking_params.h"
+
+
+static std::shared_ptr<HelloImGui::DockableWindow> MakeWindow(const std::string& label, const std::string& dockSpaceName)
+{
+    auto r = std::make_shared<HelloImGui::DockableWindow>();
+    r->label = label;
+    r->dockSpaceName = dockSpaceName;
+    return r;
+}
+
+
+TEST_CASE("testing DockableWindowRegistry")
+{
+    HelloImGui::DockingParams root;
+    auto tools = MakeWindow("Tools", "MainDockSpace");
+    tools->dockingParams.dockingSplits.push_back(HelloImGui::DockingSplit("MainDockSpace", "ToolsBottom", ImGuiDir_Down));
+    tools->dockingParams.dockableWindows.push_back(MakeWindow("Inspector###inspector", "Tools"));
+    root.dockableWindows.push_back(MakeWindow("Logs", "MainDockSpace"));
+    root.dockableWindows.push_back(tools);
+
+    HelloImGui::DockableWindowRegistry registry;
+
+    // Lookup by label, by "###" id, and by split dockspace
+    auto inspector = registry.Find(root, "Inspector###inspector");
+    REQUIRE(inspector.has_value());
+    CHECK(inspector->path.size() == 2);
+    CHECK(registry.Find(root, "Renamed###inspector")->window == inspector->window);
+    CHECK(registry.FindSplitOwner(root, "ToolsBottom")->window == tools);
+    CHECK_FALSE(registry.Find(root, "Missing").has_value());
+
+    // Append under a parent
+    auto toolsLocation = registry.Find(root, "Tools");
+    registry.Append(root, &toolsLocation.value(), MakeWindow("Console", "ToolsBottom"));
+    CHECK(tools->dockingParams.dockableWindows.size() == 2);
+    CHECK(registry.Find(root, "Console")->siblings == &tools->dockingParams.dockableWindows);
+
+    // Removing a window shifts its next siblings, which are still found
+    CHECK(registry.Remove(root, "Logs"));
+    CHECK(root.dockableWindows.size() == 1);
+    CHECK_FALSE(registry.Find(root, "Logs").has_value());
+    CHECK(registry.Find(root, "Console").has_value());
+
+    // Windows added directly in the vectors are found after Validate(), removed ones are never returned
+    root.dockableWindows.push_back(MakeWindow("Direct", "MainDockSpace"));
+    CHECK_FALSE(registry.Find(root, "Direct").has_value());
+    registry.Validate(root);
+    CHECK(registry.Find(root, "Direct").has_value());
+    tools->dockingParams.dockableWindows.clear();
+    CHECK_FALSE(registry.Find(root, "Console").has_value());
+
+    // Dockspaces created by the root splits are owned by the root
+    root.dockingSplits.push_back(HelloImGui::DockingSplit("MainDockSpace", "RootBottom", ImGuiDir_Down));
+    registry.Validate(root);
+    auto rootSplitOwner = registry.FindSplitOwner(root, "RootBottom");
+    REQUIRE(rootSplitOwner.has_value());
+    CHECK(rootSplitOwner->window == nullptr);
+    registry.Append(root, &rootSplitOwner.value(), MakeWindow("Bottom", "RootBottom"));
+    CHECK(registry.Find(root, "Bottom")->siblings == &root.dockableWindows);
+}
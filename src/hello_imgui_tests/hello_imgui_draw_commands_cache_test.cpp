@@ -0,0 +1,82 @@
+#include "doctest.h"
+#include "hello_imgui/internal/draw_commands_cache.h"
+#include "imgui.h"
+#include "hello_imgui/internal/imgui_global_context.h" // must be included before imgui_internal.h
+#include "imgui_internal.h"
+
+
+static void AddQuad(ImDrawList* drawList, float x)
+{
+    drawList->PrimReserve(6, 4);
+    unsigned int vtxStart = drawList->_VtxCurrentIdx;
+    for (int i = 0; i < 4; ++i)
+    {
+        ImDrawVert v;
+        v.pos = ImVec2(x + (float)(i % 2), (float)(i / 2));
+        v.uv = ImVec2(0.f, 0.f);
+        v.col = IM_COL32_WHITE;
+        *drawList->_VtxWritePtr++ = v;
+    }
+    const int quadIndices[6] = {0, 1, 2, 1, 3, 2};
+    for (int quadIndex : quadIndices)
+        *drawList->_IdxWritePtr++ = (ImDrawIdx)(vtxStart + (unsigned int)quadIndex);
+    drawList->_VtxCurrentIdx += 4;
+}
+
+static ImVec2 IndexedVertexPos(const ImDrawList& drawList, int idx)
+{
+    return drawList.VtxBuffer[(int)drawList.IdxBuffer[idx]].pos;
+}
+
+
+TEST_CASE("testing DrawCommandsCache")
+{
+    ImDrawListSharedData sharedData;
+    ImDrawList drawList(&sharedData);
+    drawList._ResetForNewFrame();
+    drawList.PushClipRect(ImVec2(0.f, 0.f), ImVec2(100.f, 100.f));
+
+    // The capture starts in the middle of the current draw command
+    AddQuad(&drawList, 0.f);
+    int idxStart = drawList.IdxBuffer.Size;
+    HelloImGui::DrawCommandsCache cache;
+    cache.BeginCapture(&drawList);
+    AddQuad(&drawList, 10.f);
+    drawList.PushClipRect(ImVec2(0.f, 0.f), ImVec2(50.f, 50.f));
+    AddQuad(&drawList, 20.f);
+    drawList.PopClipRect();
+    REQUIRE(cache.EndCapture(&drawList));
+    CHECK(cache.IsValid());
+
+    // Replay after some existing content: the indices shall be rebased
+    ImDrawList replayList(&sharedData);
+    replayList._ResetForNewFrame();
+    replayList.PushClipRect(ImVec2(0.f, 0.f), ImVec2(100.f, 100.f));
+    AddQuad(&replayList, 30.f);
+    cache.Replay(&replayList);
+
+    // Only the two quads added during the capture are replayed
+    REQUIRE(replayList.VtxBuffer.Size == 4 + 8);
+    REQUIRE(replayList.IdxBuffer.Size == 6 + 12);
+    for (int i = 0; i < 12; ++i)
+    {
+        ImVec2 expected = IndexedVertexPos(drawList, idxStart + i);
+        ImVec2 replayed = IndexedVertexPos(replayList, 6 + i);
+        CHECK(replayed.x == expected.x);
+        CHECK(replayed.y == expected.y);
+    }
+
+    // The clip rect of the second quad is kept
+    int nbElemsClipped = 0;
+    for (const ImDrawCmd& cmd : replayList.CmdBuffer)
+        if (cmd.ClipRect.z == 50.f)
+            nbElemsClipped += (int)cmd.ElemCount;
+    CHECK(nbElemsClipped == 6);
+
+    // A capture which contains a user callback cannot be replayed
+    cache.BeginCapture(&drawList);
+    drawList.AddCallback([](const ImDrawList*, const ImDrawCmd*) {}, nullptr);
+    AddQuad(&drawList, 40.f);
+    CHECK_FALSE(cache.EndCapture(&drawList));
+    CHECK_FALSE(cache.IsValid());
+}
@@ -0,0 +1,105 @@
+#include "doctest.h"
+#include "hello_imgui/internal/draw_data_hash.h"
+
+
+static void FillDrawList(ImDrawList* drawList, float x)
+{
+    ImDrawCmd cmd;
+    cmd.ClipRect = ImVec4(0.f, 0.f, 100.f, 100.f);
+    cmd.ElemCount = 3;
+    drawList->CmdBuffer.push_back(cmd);
+    for (int i = 0; i < 3; ++i)
+    {
+        ImDrawVert v;
+        v.pos = ImVec2(x + (float)i, 10.f * (float)i);
+        v.uv = ImVec2(0.f, 0.f);
+        v.col = IM_COL32_WHITE;
+        drawList->VtxBuffer.push_back(v);
+        drawList->IdxBuffer.push_back((ImDrawIdx)i);
+    }
+}
+
+
+TEST_CASE("testing ComputeDrawDataHash")
+{
+    ImDrawList drawListA(nullptr), drawListB(nullptr);
+    FillDrawList(&drawListA, 1.f);
+    FillDrawList(&drawListB, 1.f);
+
+    auto fnHash = [](ImDrawList* drawList, ImVec4 clearColor, uint64_t* outHash)
+    {
+        ImDrawData drawData;
+        drawData.Valid = true;
+        drawData.DisplaySize = ImVec2(100.f, 100.f);
+        drawData.FramebufferScale = ImVec2(1.f, 1.f);
+        drawData.CmdLists.push_back(drawList);
+        drawData.CmdListsCount = 1;
+        bool r = HelloImGui::ComputeDrawDataHash(&drawData, clearColor, outHash);
+        drawData.CmdLists.clear(); // the draw lists are not owned by drawData
+        return r;
+    };
+
+    ImVec4 clearColor(0.f, 0.f, 0.f, 1.f);
+    uint64_t hashA = 0, hashB = 0;
+    REQUIRE(fnHash(&drawListA, clearColor, &hashA));
+    REQUIRE(fnHash(&drawListB, clearColor, &hashB));
+    CHECK(hashA == hashB);
+
+    // A different clear color, or a moved vertex, changes the hash
+    REQUIRE(fnHash(&drawListB, ImVec4(1.f, 0.f, 0.f, 1.f), &hashB));
+    CHECK(hashA != hashB);
+    drawListB.VtxBuffer[1].pos.x += 0.5f;
+    REQUIRE(fnHash(&drawListB, clearColor, &hashB));
+    CHECK(hashA != hashB);
+
+    // Draw data with user callbacks cannot be hashed
+    ImDrawCmd callbackCmd;
+    callbackCmd.UserCallback = [](const ImDrawList*, const ImDrawCmd*) {};
+    drawListB.CmdBuffer.push_back(callbackCmd);
+    CHECK_FALSE(fnHash(&drawListB, clearColor, &hashB));
+}
+
+
+TEST_CASE("testing DrawListsDeltaTracker")
+{
+    ImDrawList drawListA(nullptr), drawListB(nullptr);
+    FillDrawList(&drawListA, 1.f);
+    FillDrawList(&drawListB, 2.f);
+
+    ImDrawData drawData;
+    drawData.Valid = true;
+    drawData.DisplaySize = ImVec2(100.f, 100.f);
+    drawData.CmdLists.push_back(&drawListA);
+    drawData.CmdLists.push_back(&drawListB);
+    drawData.CmdListsCount = 2;
+
+    HelloImGui::DrawListsDeltaTracker tracker;
+    size_t drawListSize = HelloImGui::DrawListByteSize(&drawListA);
+
+    // First frame: everything changed
+    HelloImGui::DrawListsDelta delta = tracker.Update(&drawData);
+    CHECK(delta.nbChangedDrawLists == 2);
+    CHECK(delta.totalBytes == 2 * drawListSize);
+    CHECK(delta.HasChanges());
+
+    // Same frame: nothing changed
+    delta = tracker.Update(&drawData);
+    CHECK(delta.nbChangedDrawLists == 0);
+    CHECK(delta.changedBytes == 0);
+    CHECK_FALSE(delta.HasChanges());
+
+    // Only the second draw list changed
+    drawListB.VtxBuffer[0].col = IM_COL32_BLACK;
+    delta = tracker.Update(&drawData);
+    CHECK(delta.nbChangedDrawLists == 1);
+    CHECK(delta.changedBytes == drawListSize);
+
+    // A removed draw list is a change
+    drawData.CmdLists.pop_back();
+    drawData.CmdListsCount = 1;
+    delta = tracker.Update(&drawData);
+    CHECK(delta.nbChangedDrawLists == 0);
+    CHECK(delta.HasChanges());
+
+    drawData.CmdLists.clear(); // the draw lists are not owned by drawData
+}
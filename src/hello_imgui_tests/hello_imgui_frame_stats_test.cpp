@@ -0,0 +1,50 @@
+#include "doctest.h"
+#include "hello_imgui/internal/frame_stats_ring.h"
+
+
+TEST_CASE("testing FrameStatsRing")
+{
+    HelloImGui::FrameStatsRing ring;
+    CHECK(ring.FrameRate(0.5) == 0.f);
+    CHECK(ring.Stats(1. / 60.).nbFrames == 0);
+
+    // 100 frames at 50 fps, then a 100ms hitch
+    double t = 100000.; // large timestamps (~1 day of uptime) shall not lose precision
+    for (int i = 0; i < 100; ++i)
+    {
+        ring.AddFrame(t);
+        t += 0.02;
+    }
+    t += 0.08;
+    ring.AddFrame(t);
+
+    auto stats = ring.Stats(1. / 30.);
+    CHECK(stats.nbFrames == 100);
+    CHECK(stats.minFrameTime == doctest::Approx(0.02));
+    CHECK(stats.maxFrameTime == doctest::Approx(0.1));
+    CHECK(stats.p50FrameTime == doctest::Approx(0.02));
+    CHECK(stats.p99FrameTime == doctest::Approx(0.02));
+    CHECK(stats.nbJankFrames == 1);
+    CHECK(stats.meanFrameTime == doctest::Approx((99 * 0.02 + 0.1) / 100.));
+
+    // Over the last second: 45 intervals of 20ms + the 100ms hitch
+    CHECK(ring.FrameRate(1.0) == doctest::Approx(46. / (45 * 0.02 + 0.1)).epsilon(0.01));
+}
+
+
+TEST_CASE("testing FrameStatsRing wrap around")
+{
+    HelloImGui::FrameStatsRing ring;
+    double t = 0.;
+    for (int i = 0; i < HelloImGui::FrameStatsRing::Capacity * 3; ++i)
+    {
+        ring.AddFrame(t);
+        t += 0.01;
+    }
+    CHECK(ring.NbFramesTotal() == (uint64_t)HelloImGui::FrameStatsRing::Capacity * 3);
+    auto stats = ring.Stats(1. / 60.);
+    CHECK(stats.nbFrames == HelloImGui::FrameStatsRing::Capacity - 1);
+    CHECK(stats.maxFrameTime == doctest::Approx(0.01));
+    CHECK(stats.nbJankFrames == 0);
+    CHECK(ring.FrameRate(0.5) == doctest::Approx(100.f).epsilon(0.01));
+}
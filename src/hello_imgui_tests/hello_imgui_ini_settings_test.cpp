@@ -1,6 +1,9 @@
 #include "doctest.h"
 #include "hello_imgui/internal/hello_imgui_ini_settings.h"
 
+#include <cstdio>
+#include <fstream>
+
 
 TEST_CASE("testing HelloImGuiIniSettings::SplitIniParts")
 {
@@ -58,4 +61,38 @@ WindowSize=971,691
 
     auto joined = HelloImGui::HelloImGuiIniSettings::JoinIniParts(iniParts);
     CHECK(joined == s + "\n");
-}
\ No newline at end of file
+}
+
+TEST_CASE("testing HelloImGuiIniSettings IniParts cache")
+{
+    using namespace HelloImGui::HelloImGuiIniSettings;
+    std::string filename = "hello_imgui_ini_parts_cache_test.ini";
+    std::remove(filename.c_str());
+
+    {
+        IniParts iniParts = LoadIniPartsCached(filename);
+        CHECK(iniParts.Parts.empty());
+        iniParts.SetIniPart("a", "content_a\n");
+        StoreIniPartsCached(filename, iniParts);
+
+        iniParts = LoadIniPartsCached(filename);
+        CHECK(iniParts.GetIniPart("a") == "content_a\n");
+        iniParts.SetIniPart("b", "content_b\n");
+        StoreIniPartsCached(filename, iniParts);
+    }
+
+    FlushIniPartsCache();
+    {
+        // The file contains both stores, and the temporary file was renamed
+        IniParts iniParts = IniParts::LoadFromFile(filename);
+        CHECK(iniParts.Parts.size() == 2);
+        CHECK(iniParts.GetIniPart("a") == "content_a\n");
+        CHECK(iniParts.HasIniPart("b"));
+        std::ifstream tempFile(filename + ".tmp");
+        CHECK(!tempFile.good());
+    }
+
+    ForgetIniPartsCache(filename);
+    std::remove(filename.c_str());
+    CHECK(LoadIniPartsCached(filename).Parts.empty());
+}
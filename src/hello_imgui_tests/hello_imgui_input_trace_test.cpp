@@ -0,0 +1,60 @@
+#include "doctest.h"
+#include "hello_imgui/internal/input_recorder.h"
+
+#include <cstdio>
+#include <filesystem>
+
+
+TEST_CASE("testing input traces")
+{
+    std::string filename = (std::filesystem::temp_directory_path() / "hello_imgui_input_trace_test.hiir").string();
+
+    std::vector<HelloImGui::InputTraceFrame> frames(3);
+    frames[0].deltaTime = 1.f / 60.f;
+    frames[0].displaySize[0] = 1280.f;
+    frames[0].displaySize[1] = 720.f;
+    frames[1].deltaTime = 0.02f;
+    frames[1].framebufferScale[0] = frames[1].framebufferScale[1] = 2.f;
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        HelloImGui::InputTraceEvent e;
+        e.type = (uint8_t)(i + 1);
+        e.down = (uint8_t)(i % 2);
+        e.code = 1000 + i;
+        e.x = (float)i * 1.5f;
+        e.y = -(float)i;
+        frames[1].events.push_back(e);
+    }
+    // frames[2] has no event
+
+    REQUIRE(HelloImGui::WriteInputTrace(filename, frames));
+    std::vector<HelloImGui::InputTraceFrame> readFrames;
+    REQUIRE(HelloImGui::ReadInputTrace(filename, &readFrames));
+    REQUIRE(readFrames.size() == 3);
+    CHECK(readFrames[0].deltaTime == frames[0].deltaTime);
+    CHECK(readFrames[0].displaySize[0] == 1280.f);
+    CHECK(readFrames[0].displaySize[1] == 720.f);
+    CHECK(readFrames[1].framebufferScale[1] == 2.f);
+    REQUIRE(readFrames[1].events.size() == 5);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        const auto& a = frames[1].events[i];
+        const auto& b = readFrames[1].events[i];
+        CHECK(a.type == b.type);
+        CHECK(a.down == b.down);
+        CHECK(a.code == b.code);
+        CHECK(a.x == b.x);
+        CHECK(a.y == b.y);
+    }
+    CHECK(readFrames[2].events.empty());
+
+    // A file which is not an input trace is rejected
+    {
+        FILE* f = fopen(filename.c_str(), "wb");
+        fputs("not a trace", f);
+        fclose(f);
+    }
+    CHECK_FALSE(HelloImGui::ReadInputTrace(filename, &readFrames));
+
+    std::filesystem::remove(filename);
+}
@@ -0,0 +1,30 @@
+#include "doctest.h"
+#include "hello_imgui/internal/backend_impls/remote_display_handler.h"
+
+
+TEST_CASE("testing ComputeRemoteProduceFps")
+{
+    HelloImGui::RemoteParams remoteParams;
+    remoteParams.fpsRemoteMax = 60.f;
+    remoteParams.fpsRemoteMin = 10.f;
+    remoteParams.fpsNoViewer = 2.f;
+
+    // No viewer
+    HelloImGui::RemoteViewerStats viewerStats;
+    CHECK(HelloImGui::ComputeRemoteProduceFps(viewerStats, remoteParams) == 2.f);
+    // Some frames are still produced, so that new viewers are detected
+    remoteParams.fpsNoViewer = 0.f;
+    CHECK(HelloImGui::ComputeRemoteProduceFps(viewerStats, remoteParams) == HelloImGui::kMinFpsNoViewer);
+
+    // A viewer with an unknown poll rate
+    viewerStats.nbViewers = 1;
+    CHECK(HelloImGui::ComputeRemoteProduceFps(viewerStats, remoteParams) == 60.f);
+
+    // A viewer polling 25 frames per second
+    viewerStats.configuredPollFps = 25.f;
+    CHECK(HelloImGui::ComputeRemoteProduceFps(viewerStats, remoteParams) == 25.f);
+
+    // A slow viewer: not less than fpsRemoteMin
+    viewerStats.configuredPollFps = 2.f;
+    CHECK(HelloImGui::ComputeRemoteProduceFps(viewerStats, remoteParams) == 10.f);
+}